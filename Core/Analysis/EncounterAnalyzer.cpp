@@ -0,0 +1,221 @@
+/*
+MIT License - iRacing Reputation System
+Análisis de encuentros en sesiones grabadas - Implementaciones
+*/
+
+#include "EncounterAnalyzer.h"
+#include "IbtColumnExtractor.h"
+#include "../IRacingSDK/IbtMappedFile.h"
+#include "../IRacingSDK/SessionInfoCache.h"
+#include "../ProximityDetector/GapEngine.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+    std::string FormatDate(std::time_t date)
+    {
+        if (date <= 0)
+            return std::string();
+
+        char buf[16];
+        // gmtime() no es reentrante y los archivos se analizan en paralelo
+        std::tm tm;
+#ifdef _WIN32
+        gmtime_s(&tm, &date);
+#else
+        gmtime_r(&date, &tm);
+#endif
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+        return buf;
+    }
+
+    // FNV-1a de 64 bits por palabras de 8 bytes: sólo identifica archivos, no es criptográfico
+    uint64_t ContentHash(const char *data, size_t size)
+    {
+        const uint64_t prime = 1099511628211ULL;
+        uint64_t hash = 14695981039346656037ULL;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * prime;
+        }
+        for (; i < size; ++i)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+        return (hash ^ size) * prime;
+    }
+
+    std::string SourceKey(const IbtMappedFile &file)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "ibt-%016llx", (unsigned long long)ContentHash(file.GetBytes(), file.GetSize()));
+        return buf;
+    }
+}
+
+bool EncounterAnalyzer::ReadSource(const std::string &path, SessionSource &source) const
+{
+    IbtMappedFile file;
+    if (!file.Open(path))
+        return false;
+
+    SessionInfoCache session;
+    session.Refresh(1, file.GetSessionInfo(), -1);
+    source.key = SourceKey(file);
+    source.subSessionId = session.Get().weekend.subSessionId;
+    source.playerCustomerId = session.Get().GetPlayerCustomerId();
+    return true;
+}
+
+bool EncounterAnalyzer::Analyze(const std::string &path, const std::vector<SessionWindow> &liveWindows, SessionEncounters &out) const
+{
+    out = SessionEncounters{};
+
+    IbtMappedFile file;
+    if (!file.Open(path))
+        return false;
+
+    IbtColumnExtractor extractor({"CarIdxLap", "CarIdxLapDistPct", "CarIdxEstTime", "CarIdxOnPitRoad", "CarIdxTrackSurface",
+                                  "SessionNum", "SessionTime"});
+    if (!extractor.Extract(file))
+        return false;
+
+    const IbtColumn *lapCol = extractor.Find("CarIdxLap");
+    const IbtColumn *pctCol = extractor.Find("CarIdxLapDistPct");
+    const IbtColumn *estCol = extractor.Find("CarIdxEstTime");
+    if (!lapCol || !pctCol || !estCol || !lapCol->Values<int>() || !pctCol->Values<float>() || !estCol->Values<float>())
+    {
+        Logger::Warning("El archivo no tiene las variables CarIdx* necesarias: " + path);
+        return false;
+    }
+
+    const int cars = std::min(pctCol->GetCount(), static_cast<int>(CarTelemetryFrame::MAX_CARS));
+    if (lapCol->GetCount() < cars || estCol->GetCount() < cars)
+        return false;
+
+    // Opcionales: sin ellas (grabaciones antiguas) no se filtra por pit road ni superficie
+    const IbtColumn *pitCol = extractor.Find("CarIdxOnPitRoad");
+    const IbtColumn *surfaceCol = extractor.Find("CarIdxTrackSurface");
+    if (pitCol && (!pitCol->Values<bool>() || pitCol->GetCount() < cars))
+        pitCol = nullptr;
+    if (surfaceCol && (!surfaceCol->Values<int>() || surfaceCol->GetCount() < cars))
+        surfaceCol = nullptr;
+    const IbtColumn *sessionNumCol = extractor.Find("SessionNum");
+    const IbtColumn *sessionTimeCol = extractor.Find("SessionTime");
+    const int *sessionNums = sessionNumCol ? sessionNumCol->Values<int>() : nullptr;
+    const double *sessionTimes = sessionTimeCol ? sessionTimeCol->Values<double>() : nullptr;
+
+    // Roster y longitud de pista del YAML del archivo
+    SessionInfoCache session;
+    session.Refresh(1, file.GetSessionInfo(), -1);
+    const SessionInfoData &info = session.Get();
+    out.source = SourceKey(file);
+    const int playerCarIdx = info.driverCarIdx;
+    if (playerCarIdx < 0 || playerCarIdx >= cars)
+    {
+        Logger::Warning("El archivo no indica el coche del jugador: " + path);
+        return false;
+    }
+    const int playerCustomerId = info.GetPlayerCustomerId();
+    if (!liveWindows.empty() && (!sessionNums || !sessionTimes))
+        Logger::Warning("Sin SessionNum/SessionTime no se pueden descontar los tramos en vivo: " + path);
+
+    const float tickSeconds = file.GetTickRate() > 0 ? 1.0f / file.GetTickRate() : 0.0f;
+    int encounters[CarTelemetryFrame::MAX_CARS] = {};
+    float secondsNear[CarTelemetryFrame::MAX_CARS] = {};
+    unsigned char wasNear[CarTelemetryFrame::MAX_CARS] = {};
+    float closestGap[CarTelemetryFrame::MAX_CARS];
+    int closestLap[CarTelemetryFrame::MAX_CARS] = {};
+    std::fill_n(closestGap, CarTelemetryFrame::MAX_CARS, GapEngine::INVALID_GAP);
+
+    CarTelemetryFrame frame;
+    for (int r = 0; r < extractor.GetRecordCount(); ++r)
+    {
+        std::copy_n(lapCol->Record<int>(r), cars, frame.lap);
+        std::copy_n(pctCol->Record<float>(r), cars, frame.lapDistPct);
+        std::copy_n(estCol->Record<float>(r), cars, frame.estTime);
+        if (pitCol)
+            std::copy_n(pitCol->Record<bool>(r), cars, frame.onPitRoad);
+        if (surfaceCol)
+            std::copy_n(surfaceCol->Record<int>(r), cars, frame.trackSurface);
+        GapEngine::Compute(frame, playerCarIdx, info.weekend.trackLengthMeters);
+
+        // Tramo de SessionTime de cada SessionNum; sin estas variables, uno solo para todo el archivo
+        const int sessionNum = sessionNums ? sessionNums[r] : -1;
+        const double sessionTime = sessionTimes ? sessionTimes[r] : 0.0;
+        auto window = std::find_if(out.windows.begin(), out.windows.end(), [sessionNum](const SessionWindow &w)
+                                   { return w.sessionNum == sessionNum; });
+        if (window == out.windows.end())
+        {
+            SessionWindow first;
+            first.subSessionId = info.weekend.subSessionId;
+            first.customerId = playerCustomerId;
+            first.sessionNum = sessionNum;
+            first.startTime = first.endTime = sessionTime;
+            window = out.windows.insert(out.windows.end(), first);
+        }
+        window->startTime = std::min(window->startTime, sessionTime);
+        window->endTime = std::max(window->endTime, sessionTime);
+
+        // Un tramo visto en vivo ya está guardado: se sigue el estado de cada coche para que el
+        // encuentro en curso al salir del tramo no cuente como nuevo, pero no se suma nada
+        bool seenLive = false;
+        for (size_t w = 0; sessionNums && sessionTimes && w < liveWindows.size() && !seenLive; ++w)
+            seenLive = liveWindows[w].sessionNum == sessionNum && sessionTime >= liveWindows[w].startTime &&
+                       sessionTime <= liveWindows[w].endTime;
+        out.liveRecords += seenLive;
+        const unsigned char counted = !seenLive;
+
+        // Mismo criterio que EncounterTracker: gap más corto y vuelta del jugador en ese momento
+        const int playerLap = frame.lap[playerCarIdx];
+        for (int i = 0; i < cars; ++i)
+        {
+            const float gap = std::abs(frame.gapToPlayer[i]);
+            const unsigned char near = frame.gapValid[i] && gap <= m_proximitySeconds;
+            const bool closer = counted && near && gap < closestGap[i];
+            encounters[i] += counted & near & !wasNear[i];
+            secondsNear[i] += (counted & near) * tickSeconds;
+            closestGap[i] = closer ? gap : closestGap[i];
+            closestLap[i] = closer ? playerLap : closestLap[i];
+            wasNear[i] = near;
+        }
+    }
+    out.records = extractor.GetRecordCount();
+
+    // Un archivo sin registros también queda marcado como importado
+    if (out.windows.empty())
+    {
+        SessionWindow empty;
+        empty.subSessionId = info.weekend.subSessionId;
+        empty.customerId = playerCustomerId;
+        out.windows.push_back(empty);
+    }
+
+    const std::string seen = FormatDate(file.GetSubHeader()->sessionStartDate);
+    for (const auto &driver : info.roster->drivers)
+    {
+        if (driver.carIdx < 0 || driver.carIdx >= cars || driver.carIdx == playerCarIdx || driver.customerId <= 0)
+            continue;
+        // Sin encuentros nuevos pero con tiempo cerca: un encuentro que empezó en un tramo en vivo
+        if (encounters[driver.carIdx] == 0 && secondsNear[driver.carIdx] <= 0.0f)
+            continue;
+
+        EncounterSummary summary;
+        summary.customerId = driver.customerId;
+        summary.userName = driver.userName;
+        summary.encounters = encounters[driver.carIdx];
+        summary.secondsNear = secondsNear[driver.carIdx];
+        summary.closestGap = closestGap[driver.carIdx];
+        summary.closestLap = closestLap[driver.carIdx];
+        summary.seen = seen;
+        out.encounters.push_back(std::move(summary));
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+/*
+MIT License - iRacing Reputation System
+Análisis de encuentros con otros pilotos en una sesión grabada (.ibt)
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../../Utils/Common/Types.h"
+
+// Lo que identifica un archivo sin analizarlo
+struct SessionSource
+{
+    std::string key;          // Clave de importación: hash del contenido
+    int subSessionId = 0;     // 0 sin SubSessionID en el YAML
+    int playerCustomerId = 0;
+};
+
+// Resultado de analizar un archivo
+struct SessionEncounters
+{
+    std::string source;   // Clave de importación (SessionSource::key)
+    int records = 0;      // Registros de telemetría recorridos
+    int liveRecords = 0;  // De ellos, los que caen en un tramo ya guardado en vivo
+    std::vector<SessionWindow> windows; // Uno por SessionNum presente en el archivo
+    std::vector<EncounterSummary> encounters;
+};
+
+/**
+ * @brief Cuenta cuántas veces se acercó cada piloto al jugador durante la sesión
+ *
+ * Extrae en columnas las variables CarIdx* del archivo, calcula los gaps registro a
+ * registro con GapEngine (lo mismo que en vivo) y cuenta una entrada cada vez que un
+ * coche pasa a estar dentro del umbral de proximidad. Los carIdx se traducen a
+ * customerId con el roster del YAML del archivo. Sin estado compartido: se puede
+ * llamar desde varios hilos a la vez.
+ *
+ * La clave de importación identifica la grabación, no el evento: es un hash del
+ * contenido, así que una copia renombrada o movida se salta y los .ibt de práctica y
+ * carrera de una misma SubSessionID se importan cada uno. SubSessionID, jugador y
+ * rango de SessionTime de cada SessionNum van aparte, en SessionEncounters::windows.
+ *
+ * Los registros que caen en un tramo ya guardado en vivo (mismo SessionNum y SessionTime
+ * dentro del tramo) no suman encuentros: sólo se importa lo que el seguimiento en vivo no vio.
+ */
+class EncounterAnalyzer
+{
+public:
+    explicit EncounterAnalyzer(float proximitySeconds = 2.0f) : m_proximitySeconds(proximitySeconds) {}
+
+    // Sólo abre el archivo, calcula su clave y lee su SubSessionID, para saltar los ya
+    // importados sin analizarlos y buscar sus tramos en vivo
+    bool ReadSource(const std::string &path, SessionSource &source) const;
+
+    // liveWindows: tramos de la misma SubSessionID y jugador (ReputationRepository::LoadLiveWindows)
+    bool Analyze(const std::string &path, const std::vector<SessionWindow> &liveWindows, SessionEncounters &out) const;
+
+private:
+    float m_proximitySeconds;
+};
@@ -0,0 +1,171 @@
+/*
+MIT License - iRacing Reputation System
+Seguimiento en vivo de encuentros con otros pilotos - Implementaciones
+*/
+
+#include "EncounterTracker.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+namespace
+{
+    // En UTC, como la fecha que EncounterAnalyzer saca de sessionStartDate
+    std::string Today()
+    {
+        std::time_t now = std::time(nullptr);
+        std::tm tm;
+#ifdef _WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif
+        char buf[16];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d", &tm);
+        return buf;
+    }
+} // namespace
+
+EncounterTracker::EncounterTracker(float proximitySeconds)
+    : m_proximitySeconds(proximitySeconds)
+{
+    m_pending.reserve(MAX_PENDING_DRIVERS);
+}
+
+void EncounterTracker::OnTick(double sessionTime, int playerCarIdx, const CarTelemetryFrame &frame, const RosterSnapshot &roster)
+{
+    if (playerCarIdx != m_playerCarIdx || sessionTime < m_lastTime)
+    {
+        CloseAll();
+        m_playerCarIdx = playerCarIdx;
+    }
+    m_lastTime = sessionTime;
+
+    const int playerLap = playerCarIdx >= 0 && playerCarIdx < MAX_CARS ? frame.lap[playerCarIdx] : 0;
+
+    // Máscara sin ramas como en EncounterAnalyzer; sólo los cambios de estado pasan al roster
+    unsigned char near[MAX_CARS];
+    for (int i = 0; i < MAX_CARS; ++i)
+        near[i] = static_cast<unsigned char>(frame.gapValid[i] & (std::abs(frame.gapToPlayer[i]) <= m_proximitySeconds));
+
+    for (int i = 0; i < MAX_CARS; ++i)
+    {
+        OpenEncounter &encounter = m_open[i];
+        if (!near[i])
+        {
+            if (encounter.open)
+                Close(i);
+            continue;
+        }
+
+        if (!encounter.open)
+        {
+            const DriverData *driver = roster.FindByCarIdx(i);
+            if (!driver || driver->customerId <= 0)
+                continue;
+
+            encounter.open = true;
+            encounter.customerId = driver->customerId;
+            encounter.userName = driver->userName;
+            encounter.startTime = sessionTime;
+            encounter.closestGap = 999.0f;
+        }
+
+        encounter.lastTime = sessionTime;
+        const float gap = std::abs(frame.gapToPlayer[i]);
+        if (gap < encounter.closestGap)
+        {
+            encounter.closestGap = gap;
+            encounter.lap = playerLap;
+        }
+    }
+}
+
+void EncounterTracker::CloseAll()
+{
+    for (int i = 0; i < MAX_CARS; ++i)
+    {
+        if (m_open[i].open)
+            Close(i);
+    }
+}
+
+void EncounterTracker::Close(int carIdx)
+{
+    OpenEncounter &encounter = m_open[carIdx];
+    encounter.open = false;
+
+    // Acumular por piloto hasta el siguiente TakePending()
+    EncounterSummary *summary = nullptr;
+    for (auto &pending : m_pending)
+    {
+        if (pending.customerId == encounter.customerId)
+        {
+            summary = &pending;
+            break;
+        }
+    }
+    if (!summary)
+    {
+        if (m_pending.size() >= static_cast<size_t>(MAX_PENDING_DRIVERS))
+        {
+            m_droppedCount++;
+            return;
+        }
+        m_pending.emplace_back();
+        summary = &m_pending.back();
+        summary->customerId = encounter.customerId;
+        summary->userName = encounter.userName;
+        summary->seen = Today();
+    }
+    summary->encounters++;
+    summary->secondsNear += static_cast<float>(encounter.lastTime - encounter.startTime);
+    if (encounter.closestGap < summary->closestGap)
+    {
+        summary->closestGap = encounter.closestGap;
+        summary->closestLap = encounter.lap;
+    }
+}
+
+bool EncounterTracker::TakePending(std::vector<EncounterSummary> &out)
+{
+    if (m_droppedCount > 0)
+    {
+        Logger::WarningF("Encuentros descartados por superar %d pilotos pendientes: %d", MAX_PENDING_DRIVERS, m_droppedCount);
+        m_droppedCount = 0;
+    }
+
+    out.clear();
+    if (m_pending.empty())
+        return false;
+
+    out.swap(m_pending);
+    m_pending.clear();
+    m_pending.reserve(MAX_PENDING_DRIVERS);
+    return true;
+}
+
+void EncounterTracker::MergeInto(std::vector<EncounterSummary> &into, const std::vector<EncounterSummary> &from)
+{
+    for (const auto &e : from)
+    {
+        auto it = std::find_if(into.begin(), into.end(), [&](const EncounterSummary &x)
+                               { return x.customerId == e.customerId; });
+        if (it == into.end())
+        {
+            into.push_back(e);
+            continue;
+        }
+
+        it->encounters += e.encounters;
+        it->secondsNear += e.secondsNear;
+        if (e.closestGap < it->closestGap)
+        {
+            it->closestGap = e.closestGap;
+            it->closestLap = e.closestLap;
+        }
+        if (e.seen > it->seen)
+            it->seen = e.seen;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+MIT License - iRacing Reputation System
+Seguimiento en vivo de encuentros con otros pilotos
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../../Utils/Common/Types.h"
+
+/**
+ * @brief Abre un encuentro cuando un coche entra en el umbral de proximidad y lo cierra al salir
+ *
+ * Mismo criterio que EncounterAnalyzer (|gapToPlayer| <= proximitySeconds). La aplicación guarda
+ * los lotes con la clave de cada seguimiento en vivo y los tramos de SessionTime que cubre, que
+ * el importador de .ibt descuenta. Recibe los ticks en orden (un cursor
+ * propio en el anillo de frames) y acumula por piloto los encuentros cerrados, con el gap más
+ * corto y la vuelta en que se dio, hasta que se recogen con TakePending() para guardarlos en
+ * lote con ReputationRepository.
+ *
+ * Memoria acotada: un encuentro abierto por carIdx y como mucho MAX_PENDING_DRIVERS pilotos
+ * pendientes de guardar; los encuentros que no caben se descartan y TakePending() lo avisa.
+ */
+class EncounterTracker
+{
+public:
+    static constexpr int MAX_CARS = CarTelemetryFrame::MAX_CARS;
+    static constexpr int MAX_PENDING_DRIVERS = 256;
+
+    explicit EncounterTracker(float proximitySeconds = 2.0f);
+
+    // Procesa un tick. Si SessionTime retrocede o cambia el coche del jugador, cierra lo abierto
+    void OnTick(double sessionTime, int playerCarIdx, const CarTelemetryFrame &frame, const RosterSnapshot &roster);
+
+    // Cierra los encuentros abiertos (fin de sesión, desconexión)
+    void CloseAll();
+
+    // Mueve a out los encuentros cerrados desde la última llamada, agrupados por piloto.
+    // false = nada que guardar
+    bool TakePending(std::vector<EncounterSummary> &out);
+
+    // Suma los lotes de from a la entrada de cada piloto en into (o la añade), para unir a un
+    // lote que no se pudo guardar lo recogido después sin repetir pilotos
+    static void MergeInto(std::vector<EncounterSummary> &into, const std::vector<EncounterSummary> &from);
+
+private:
+    struct OpenEncounter
+    {
+        bool open = false;
+        int customerId = -1;
+        std::string userName;
+        double startTime = 0.0;
+        double lastTime = 0.0;
+        float closestGap = 999.0f;
+        int lap = 0;
+    };
+
+    void Close(int carIdx);
+
+    float m_proximitySeconds;
+    int m_playerCarIdx = -1;
+    double m_lastTime = 0.0;
+
+    OpenEncounter m_open[MAX_CARS];
+    std::vector<EncounterSummary> m_pending; // Reservado a MAX_PENDING_DRIVERS al construir
+    int m_droppedCount = 0;                  // Encuentros descartados desde el último TakePending()
+};
@@ -0,0 +1,103 @@
+/*
+MIT License - iRacing Reputation System
+Extracción columnar de variables de un .ibt - Implementaciones
+*/
+
+#include "IbtColumnExtractor.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Registros por bloque: el bloque de origen sigue en caché mientras se reparte en columnas
+    constexpr int RECORD_BLOCK = 64;
+}
+
+IbtColumnExtractor::IbtColumnExtractor(std::vector<std::string> varNames)
+    : m_varNames(std::move(varNames))
+{
+}
+
+bool IbtColumnExtractor::Extract(const std::string &path)
+{
+    IbtMappedFile file;
+    if (!file.Open(path))
+        return false;
+    return Extract(file);
+}
+
+bool IbtColumnExtractor::Extract(const IbtMappedFile &file)
+{
+    m_columns.clear();
+    m_recordCount = 0;
+    m_tickRate = 0;
+    m_sessionInfo.clear();
+
+    if (!file.IsOpen())
+        return false;
+
+    m_recordCount = file.GetRecordCount();
+    m_tickRate = file.GetTickRate();
+    m_sessionInfo = file.GetSessionInfo();
+
+    // Resolver cada variable una sola vez
+    const irsdk_varHeader *headers = file.GetVarHeaders();
+    for (const auto &name : m_varNames)
+    {
+        int idx = file.FindVar(name.c_str());
+        if (idx < 0)
+        {
+            Logger::Warning("Variable no presente en el .ibt: " + name);
+            continue;
+        }
+
+        const irsdk_varHeader &header = headers[idx];
+        if (header.offset < 0 || header.count <= 0 || header.type < 0 || header.type >= irsdk_ETCount ||
+            static_cast<long long>(header.offset) + static_cast<long long>(irsdk_VarTypeBytes[header.type]) * header.count >
+                file.GetBufLen())
+        {
+            Logger::Warning("Cabecera no válida en el .ibt para: " + name);
+            continue;
+        }
+
+        IbtColumn column;
+        column.m_name = name;
+        column.m_type = header.type;
+        column.m_count = header.count;
+        column.m_recordCount = m_recordCount;
+        column.m_offset = header.offset;
+        column.m_bytes = irsdk_VarTypeBytes[header.type] * header.count;
+
+        const size_t totalBytes = static_cast<size_t>(column.m_bytes) * m_recordCount;
+        column.m_data.resize((totalBytes + sizeof(double) - 1) / sizeof(double));
+        m_columns.push_back(std::move(column));
+    }
+
+    // Una pasada por el archivo: cada registro reparte su bloque de bytes en las columnas
+    for (int blockStart = 0; blockStart < m_recordCount; blockStart += RECORD_BLOCK)
+    {
+        const int blockEnd = std::min(blockStart + RECORD_BLOCK, m_recordCount);
+        for (auto &column : m_columns)
+        {
+            char *dst = reinterpret_cast<char *>(column.m_data.data()) + static_cast<size_t>(blockStart) * column.m_bytes;
+            for (int r = blockStart; r < blockEnd; ++r)
+            {
+                memcpy(dst, file.GetRecord(r) + column.m_offset, column.m_bytes);
+                dst += column.m_bytes;
+            }
+        }
+    }
+
+    return true;
+}
+
+const IbtColumn *IbtColumnExtractor::Find(const std::string &name) const
+{
+    for (const auto &column : m_columns)
+    {
+        if (column.m_name == name)
+            return &column;
+    }
+    return nullptr;
+}
@@ -0,0 +1,87 @@
+/*
+MIT License - iRacing Reputation System
+Extracción columnar de variables de un .ibt (post-carrera)
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../IRacingSDK/IbtMappedFile.h"
+#include "../IRacingSDK/TelemetryVarRegistry.h"
+
+/**
+ * @brief Una variable del .ibt decodificada para todos los registros
+ *
+ * Los valores quedan contiguos en el tipo nativo del archivo: registro r, elemento e
+ * en Values<T>()[r * GetCount() + e]. Las variables CarIdx* dan así una matriz
+ * registros x 64 lista para recorrer sin conversiones.
+ */
+class IbtColumn
+{
+public:
+    const std::string &GetName() const { return m_name; }
+    int GetType() const { return m_type; }
+    int GetCount() const { return m_count; } // Elementos por registro
+    int GetRecordCount() const { return m_recordCount; }
+
+    // nullptr si T no es el tipo de la variable (bitField se lee como int)
+    template <typename T>
+    const T *Values() const
+    {
+        const int type = m_type == irsdk_bitField ? irsdk_int : m_type;
+        if (type != TelemetryVars::VarType<T>::value)
+            return nullptr;
+        return reinterpret_cast<const T *>(m_data.data());
+    }
+
+    template <typename T>
+    const T *Record(int record) const
+    {
+        const T *values = Values<T>();
+        return values ? values + static_cast<size_t>(record) * m_count : nullptr;
+    }
+
+private:
+    friend class IbtColumnExtractor;
+
+    std::string m_name;
+    int m_type = irsdk_char;
+    int m_count = 0;
+    int m_recordCount = 0;
+    int m_offset = 0; // Offset en la fila del .ibt
+    int m_bytes = 0;  // Bytes por registro
+    std::vector<double> m_data; // double para que cualquier tipo quede alineado
+};
+
+/**
+ * @brief Decodifica las variables pedidas de un .ibt completo en una sola pasada
+ *
+ * En lugar de getNextData() + getVarFloat(idx, entry) por elemento, con su switch
+ * de tipo, cada variable se resuelve una vez contra las cabeceras y en cada registro
+ * se copia su bloque de bytes tal cual. Se recorre el archivo mapeado por bloques de
+ * registros para que la lectura siga siendo secuencial mientras se escriben las columnas.
+ */
+class IbtColumnExtractor
+{
+public:
+    explicit IbtColumnExtractor(std::vector<std::string> varNames);
+
+    // Devuelve false si el archivo no se puede leer; las variables que falten se omiten
+    bool Extract(const std::string &path);
+    bool Extract(const IbtMappedFile &file);
+
+    const IbtColumn *Find(const std::string &name) const;
+    const std::vector<IbtColumn> &GetColumns() const { return m_columns; }
+    int GetRecordCount() const { return m_recordCount; }
+    int GetTickRate() const { return m_tickRate; }
+    const std::string &GetSessionInfo() const { return m_sessionInfo; }
+
+private:
+    std::vector<std::string> m_varNames;
+    std::vector<IbtColumn> m_columns;
+    int m_recordCount = 0;
+    int m_tickRate = 0;
+    std::string m_sessionInfo;
+};
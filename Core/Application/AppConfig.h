@@ -23,6 +23,8 @@ public:
     // Configuración de actualización
     static constexpr auto DATA_UPDATE_INTERVAL = std::chrono::seconds(2);
     static constexpr auto FRAME_TIME = std::chrono::milliseconds(16); // ~60 FPS
+    static constexpr auto IDLE_FRAME_TIME = std::chrono::milliseconds(100); // Sin sesión y ventana en segundo plano
+    static constexpr auto ENCOUNTER_FLUSH_INTERVAL = std::chrono::seconds(10); // Lotes de encuentros a la base de datos
 
     // Configuración de ventana
     static constexpr int DEFAULT_WINDOW_WIDTH = 800;
@@ -1,37 +1,146 @@
 #include "ProximityLogic.h"
+#include "../ProximityDetector/GapEngine.h"
 #include <chrono>
+#include <cmath>
 
-void ProximityLogic::CheckAndShowOverlay(int playerCarIdx, const std::vector<DriverData> &drivers, const std::map<int, DriverReputation> &reputations, float threshold)
+namespace
 {
-    const DriverData *player = nullptr;
-    for (const auto &d : drivers)
+    bool IsFlagged(const DriverData *driver, const std::map<int, DriverReputation> &reputations, const DriverReputation **out)
     {
-        if (d.carIdx == playerCarIdx)
+        if (!driver)
+            return false;
+        auto it = reputations.find(driver->customerId);
+        if (it == reputations.end())
+            return false;
+        const DriverReputation &rep = it->second;
+        if (rep.behaviorFlags == 0 || rep.behaviorFlags == static_cast<uint32_t>(DriverFlags::UNKNOWN))
+            return false;
+        *out = &rep;
+        return true;
+    }
+} // namespace
+
+void ProximityLogic::CheckAndShowOverlay(int playerCarIdx, const RosterSnapshot &roster, const CarTelemetryFrame &frame, const std::map<int, DriverReputation> &reputations, float threshold, float ttcSeconds)
+{
+    if (playerCarIdx < 0 || playerCarIdx >= CarTelemetryFrame::MAX_CARS)
+        return;
+
+    // Coches dentro del umbral por delante y por detrás, recorriendo el orden en pista
+    GapEngine::NearbyCars nearby;
+    GapEngine::FindNearby(frame, threshold, 0.0f, nearby);
+
+    // Y los que están más lejos pero se acercan rápido: una pasada sin ramas sobre timeToContact
+    unsigned char inside[CarTelemetryFrame::MAX_CARS];
+    for (int i = 0; i < CarTelemetryFrame::MAX_CARS; ++i)
+        inside[i] = static_cast<unsigned char>(frame.gapValid[i] & (frame.timeToContact[i] <= ttcSeconds));
+    for (int i = 0; i < nearby.aheadCount; ++i)
+        inside[nearby.ahead[i]] = 1;
+    for (int i = 0; i < nearby.behindCount; ++i)
+        inside[nearby.behind[i]] = 1;
+
+    const float exitMeters = threshold * EXIT_MARGIN;
+    const float exitTtc = ttcSeconds * EXIT_MARGIN;
+    const auto now = Clock::now();
+    auto secondsIn = [now](Clock::time_point since)
+    { return std::chrono::duration<float>(now - since).count(); };
+
+    bool changed = false;
+    for (int carIdx = 0; carIdx < CarTelemetryFrame::MAX_CARS; ++carIdx)
+    {
+        CarAlert &alert = m_alerts[carIdx];
+        if (alert.phase == AlertPhase::IDLE && !inside[carIdx])
+            continue;
+
+        // Sólo se consulta el roster y las reputaciones de coches dentro del umbral o con alerta en curso
+        const DriverData *driver = roster.FindByCarIdx(carIdx);
+        const int customerId = driver ? driver->customerId : -1;
+        if (alert.phase != AlertPhase::IDLE && alert.customerId != customerId)
+        {
+            changed |= alert.phase == AlertPhase::ACTIVE || alert.phase == AlertPhase::LEAVING;
+            alert = CarAlert();
+        }
+
+        switch (alert.phase)
+        {
+        case AlertPhase::IDLE:
+        {
+            const DriverReputation *rep = nullptr;
+            if (IsFlagged(driver, reputations, &rep))
+            {
+                alert.phase = AlertPhase::ENTERING;
+                alert.customerId = customerId;
+                alert.since = now;
+            }
+            break;
+        }
+        case AlertPhase::ENTERING:
+            if (!inside[carIdx])
+                alert = CarAlert();
+            else if (secondsIn(alert.since) >= ENTER_DWELL_SECONDS)
+            {
+                alert.phase = AlertPhase::ACTIVE;
+                alert.since = alert.shownAt = now;
+                changed = true;
+            }
+            break;
+        case AlertPhase::ACTIVE:
+        case AlertPhase::LEAVING:
         {
-            player = &d;
+            const bool withinExit = frame.gapValid[carIdx] && (std::abs(frame.distanceToPlayer[carIdx]) <= exitMeters ||
+                                                               frame.timeToContact[carIdx] <= exitTtc);
+            if (withinExit)
+            {
+                alert.phase = AlertPhase::ACTIVE;
+            }
+            else if (alert.phase == AlertPhase::ACTIVE)
+            {
+                alert.phase = AlertPhase::LEAVING;
+                alert.since = now;
+            }
+            else if (secondsIn(alert.since) >= EXIT_DWELL_SECONDS && secondsIn(alert.shownAt) >= MIN_SHOW_SECONDS)
+            {
+                alert.phase = AlertPhase::COOLDOWN;
+                alert.since = now;
+                changed = true;
+            }
+            break;
+        }
+        case AlertPhase::COOLDOWN:
+            if (secondsIn(alert.since) >= COOLDOWN_SECONDS)
+                alert = CarAlert();
             break;
         }
     }
-    if (!player)
-        return;
-    for (const auto &d : drivers)
+
+    // El overlay sólo se toca en transiciones, y con alertas visibles para refrescar sus gaps a ritmo limitado
+    if (changed || (m_visibleCount > 0 && secondsIn(m_lastRefresh) >= REFRESH_SECONDS))
     {
-        if (d.carIdx == playerCarIdx)
-            continue;
-        auto it = reputations.find(d.customerId);
-        if (it == reputations.end())
+        RefreshOverlay(roster, frame, reputations);
+        m_lastRefresh = now;
+    }
+}
+
+void ProximityLogic::RefreshOverlay(const RosterSnapshot &roster, const CarTelemetryFrame &frame, const std::map<int, DriverReputation> &reputations)
+{
+    ProximityCandidate candidates[CarTelemetryFrame::MAX_CARS];
+    int count = 0;
+    for (int carIdx = 0; carIdx < CarTelemetryFrame::MAX_CARS; ++carIdx)
+    {
+        const AlertPhase phase = m_alerts[carIdx].phase;
+        if (phase != AlertPhase::ACTIVE && phase != AlertPhase::LEAVING)
             continue;
-        const DriverReputation &rep = it->second;
-        if (rep.behaviorFlags == 0 || rep.behaviorFlags == static_cast<uint32_t>(DriverFlags::UNKNOWN))
+
+        const DriverData *driver = roster.FindByCarIdx(carIdx);
+        const DriverReputation *rep = nullptr;
+        if (!IsFlagged(driver, reputations, &rep))
             continue;
-        float dist = d.distanceToPlayer;
-        if (dist <= threshold)
-        {
-            // Aquí deberías obtener los tags activos del piloto
-            std::vector<TagInfo> tags; // TODO: obtener tags reales desde rep o lógica
-            overlayManager->ShowOverlay(d.carIdx, d.displayName, tags, 3.0f);
-            return;
-        }
+
+        candidates[count++] = {driver, rep, frame.gapToPlayer[carIdx], frame.isAhead[carIdx] != 0};
     }
-    overlayManager->Hide();
+
+    m_visibleCount = count;
+    if (count == 0)
+        overlayManager->Hide();
+    else
+        overlayManager->UpdateWarnings(candidates, count, 3.0f);
 }
@@ -1,5 +1,6 @@
 #include <map>
 #pragma once
+#include <chrono>
 #include <vector>
 #include "../../Utils/Common/Types.h"
 #include "../../Overlay/OverlayProximityTags.h"
@@ -7,9 +8,44 @@
 class ProximityLogic
 {
 public:
+    // Histéresis: una alerta entra con threshold / ttcSeconds y sólo sale al pasar de EXIT_MARGIN veces eso
+    static constexpr float EXIT_MARGIN = 1.5f;
+    static constexpr float ENTER_DWELL_SECONDS = 0.2f; // Tiempo dentro antes de mostrarla (ignora roces de un frame)
+    static constexpr float EXIT_DWELL_SECONDS = 0.5f;  // Tiempo fuera antes de quitarla
+    static constexpr float MIN_SHOW_SECONDS = 2.0f;    // Tiempo mínimo en pantalla
+    static constexpr float COOLDOWN_SECONDS = 5.0f;    // Tras quitarla, el mismo piloto no vuelve a avisar en este tiempo
+    static constexpr float REFRESH_SECONDS = 0.1f;     // Cada cuánto se refrescan los gaps de las alertas visibles
+
     ProximityLogic(OverlayProximityTagsManager *overlayManager) : overlayManager(overlayManager) {}
-    void CheckAndShowOverlay(int playerCarIdx, const std::vector<DriverData> &drivers, const std::map<int, DriverReputation> &reputations, float threshold = 10.0f);
+    // Avisa de los pilotos marcados a menos de threshold metros o que nos alcanzarán (o alcanzaremos)
+    // en menos de ttcSeconds según su velocidad de aproximación. Se puede llamar en cada frame:
+    // el overlay sólo se toca cuando una alerta aparece o desaparece, y para refrescar gaps cada REFRESH_SECONDS
+    void CheckAndShowOverlay(int playerCarIdx, const RosterSnapshot &roster, const CarTelemetryFrame &frame, const std::map<int, DriverReputation> &reputations, float threshold = 10.0f, float ttcSeconds = 3.0f);
 
 private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class AlertPhase : unsigned char
+    {
+        IDLE = 0,
+        ENTERING, // Dentro del umbral, esperando ENTER_DWELL_SECONDS
+        ACTIVE,   // Visible
+        LEAVING,  // Visible, fuera del umbral de salida desde hace menos de EXIT_DWELL_SECONDS
+        COOLDOWN  // Quitada hace menos de COOLDOWN_SECONDS
+    };
+
+    struct CarAlert
+    {
+        AlertPhase phase = AlertPhase::IDLE;
+        int customerId = -1; // Piloto al que se refiere (si cambia el coche de manos, se reinicia)
+        Clock::time_point since;   // Inicio de la fase actual
+        Clock::time_point shownAt; // Cuándo pasó a ACTIVE
+    };
+
+    void RefreshOverlay(const RosterSnapshot &roster, const CarTelemetryFrame &frame, const std::map<int, DriverReputation> &reputations);
+
     OverlayProximityTagsManager *overlayManager;
+    CarAlert m_alerts[CarTelemetryFrame::MAX_CARS];
+    int m_visibleCount = 0;
+    Clock::time_point m_lastRefresh;
 };
@@ -7,11 +7,13 @@ Implementación de la aplicación principal
 */
 
 #include "iRacingReputationApp.h"
+#include <algorithm>
+#include <ctime>
 #include <iostream>
 #include <thread>
 #include <windows.h>
 
-iRacingReputationApp::iRacingReputationApp()
+iRacingReputationApp::iRacingReputationApp(std::unique_ptr<ITelemetrySource> source)
 {
     // Configurar consola para UTF-8 al inicio
     SetConsoleOutputCP(65001);
@@ -21,17 +23,26 @@ iRacingReputationApp::iRacingReputationApp()
     Logger::Info("Iniciando " + std::string(AppConfig::APP_NAME) + " " + AppConfig::APP_VERSION + "...");
 
     m_driverTagWindow = std::make_unique<DriverTagWindow>();
-    m_iracingConnection = std::make_unique<IRacingConnection>();
+    m_telemetryReader = std::make_unique<TelemetryReader>(std::move(source));
+    m_tickCursor = m_telemetryReader->GetFrameRing().Subscribe();
+    m_encounterCursor = m_telemetryReader->GetFrameRing().Subscribe();
 }
 
 iRacingReputationApp::~iRacingReputationApp()
 {
     m_running = false;
 
-    // Cerrar conexión de iRacing
-    if (m_iracingConnection)
+    // Guardar los encuentros abiertos mientras la base de datos de la ventana sigue abierta
+    m_encounters.CloseAll();
+    FlushEncounters(true);
+    if (!m_encounterBatch.empty())
+        Logger::Warning("Encuentros sin guardar al cerrar: " + std::to_string(m_encounterBatch.size()) + " pilotos (" +
+                        m_encounterBatchSource + ")");
+
+    // Detener el hilo de telemetría (cierra la conexión de iRacing)
+    if (m_telemetryReader)
     {
-        m_iracingConnection->Shutdown();
+        m_telemetryReader->Stop();
     }
 
     Logger::Info("Cerrando iRacing Reputation System...");
@@ -41,8 +52,8 @@ bool iRacingReputationApp::Initialize()
 {
     Logger::Info("Inicializando componentes...");
 
-    // Inicializar conexión con iRacing
-    if (!m_iracingConnection->Initialize())
+    // Inicializar conexión con iRacing en su propio hilo
+    if (!m_telemetryReader->Start())
     {
         Logger::Warning("No se pudo conectar con iRacing - usando datos mock");
     }
@@ -68,7 +79,7 @@ bool iRacingReputationApp::Initialize()
 
 void iRacingReputationApp::UpdateDriverData()
 {
-    if (!m_iracingConnection)
+    if (!m_telemetryReader || !m_telemetryReader->IsRunning())
     {
         Logger::Error("No hay conexión de iRacing inicializada - usando mock");
         if (ShouldUseMockData())
@@ -78,8 +89,110 @@ void iRacingReputationApp::UpdateDriverData()
         return;
     }
 
-    ConnectionStatus status = m_iracingConnection->Update();
-    HandleConnectionStatus(status);
+    // No bloquea: toma el último snapshot publicado por el hilo de telemetría
+    auto snapshot = m_telemetryReader->GetSnapshot();
+    HandleConnectionStatus(*snapshot);
+
+    m_telemetryReader->GetAcquisitionStats(m_acquisitionStats);
+    m_driverTagWindow->SetAcquisitionStats(m_acquisitionStats);
+}
+
+void iRacingReputationApp::ReadLatestTick()
+{
+    // Sin tick nuevo se conserva el anterior
+    m_telemetryReader->GetFrameRing().ReadLatest(m_tickCursor, m_lastTick);
+}
+
+void iRacingReputationApp::TrackEncounters(const TelemetrySnapshot &snapshot)
+{
+    const TelemetryFrameRing &ring = m_telemetryReader->GetFrameRing();
+    if (snapshot.status != ConnectionStatus::IN_SESSION)
+    {
+        // Fuera de sesión no hay encuentros: cerrar lo abierto y saltar los ticks pendientes.
+        // Al volver empieza otro seguimiento, para que sus tramos no cubran el hueco
+        m_encounters.CloseAll();
+        FlushEncounters(true);
+        m_encounterSource.clear();
+        m_encounterCursor = ring.Subscribe();
+        return;
+    }
+
+    // Cada seguimiento en vivo tiene su propia clave y guarda los tramos de SessionTime que vio;
+    // el importador de .ibt sólo descuenta esos tramos, no la sesión entera
+    if (snapshot.subSessionId != m_encounterSubSessionId || snapshot.playerCustomerId != m_encounterCustomerId ||
+        m_encounterSource.empty())
+    {
+        m_encounters.CloseAll();
+        FlushEncounters(true);
+        m_encounterSubSessionId = snapshot.subSessionId;
+        m_encounterCustomerId = snapshot.playerCustomerId;
+        const std::string started = std::to_string((long long)std::time(nullptr));
+        m_encounterSource = snapshot.subSessionId > 0 ? "live-" + std::to_string(snapshot.subSessionId) + "-" +
+                                                            std::to_string(snapshot.playerCustomerId) + "-" + started
+                                                      : "live-" + started;
+        m_encounterWindows.clear();
+        m_encounterWindowsChanged = false;
+    }
+
+    while (ring.Read(m_encounterCursor, m_encounterTick))
+    {
+        m_encounters.OnTick(m_encounterTick.sessionTime, m_encounterTick.playerCarIdx, m_encounterTick.frame, *snapshot.roster);
+        ExtendEncounterWindow(m_encounterTick.sessionNum, m_encounterTick.sessionTime);
+    }
+
+    FlushEncounters(false);
+}
+
+void iRacingReputationApp::ExtendEncounterWindow(int sessionNum, double sessionTime)
+{
+    auto window = std::find_if(m_encounterWindows.begin(), m_encounterWindows.end(), [sessionNum](const SessionWindow &w)
+                               { return w.sessionNum == sessionNum; });
+    if (window == m_encounterWindows.end())
+    {
+        SessionWindow first;
+        first.subSessionId = m_encounterSubSessionId;
+        first.customerId = m_encounterCustomerId;
+        first.sessionNum = sessionNum;
+        first.startTime = first.endTime = sessionTime;
+        first.live = true;
+        window = m_encounterWindows.insert(m_encounterWindows.end(), first);
+    }
+    window->startTime = std::min(window->startTime, sessionTime);
+    window->endTime = std::max(window->endTime, sessionTime);
+    m_encounterWindowsChanged = true;
+}
+
+void iRacingReputationApp::FlushEncounters(bool force)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - m_lastEncounterFlush < AppConfig::ENCOUNTER_FLUSH_INTERVAL)
+        return;
+    m_lastEncounterFlush = now;
+
+    // Un lote que no se pudo guardar (sin base de datos, error de SQLite) se conserva con su clave
+    // y se reintenta. Lo recogido después se le une si es del mismo seguimiento; si es de otro, se
+    // queda en el tracker hasta que el lote anterior se guarde, para no cambiarlo de seguimiento.
+    // Los tramos van con el lote aunque no haya encuentros: marcan lo ya visto en vivo
+    while (true)
+    {
+        if (m_encounterBatch.empty() && m_encounterBatchWindows.empty())
+            m_encounterBatchSource = m_encounterSource;
+        if (!m_encounterSource.empty() && m_encounterBatchSource == m_encounterSource)
+        {
+            if (m_encounters.TakePending(m_encounterTaken))
+                EncounterTracker::MergeInto(m_encounterBatch, m_encounterTaken);
+            if (m_encounterWindowsChanged)
+                m_encounterBatchWindows = m_encounterWindows;
+            m_encounterWindowsChanged = false;
+        }
+
+        if (m_encounterBatch.empty() && m_encounterBatchWindows.empty())
+            return;
+        if (!m_driverTagWindow->ApplyEncounters(m_encounterBatchSource, m_encounterBatchWindows, m_encounterBatch))
+            return;
+        m_encounterBatch.clear();
+        m_encounterBatchWindows.clear();
+    }
 }
 
 bool iRacingReputationApp::ShouldUseMockData() const
@@ -87,18 +200,18 @@ bool iRacingReputationApp::ShouldUseMockData() const
     return !m_driverTagWindow->IsUsingRealData();
 }
 
-void iRacingReputationApp::HandleConnectionStatus(ConnectionStatus status)
+void iRacingReputationApp::HandleConnectionStatus(const TelemetrySnapshot &snapshot)
 {
-    const auto &sessionDrivers = m_iracingConnection->GetSessionDrivers();
-    LogConnectionInfo(status, sessionDrivers);
+    const auto &sessionDrivers = snapshot.roster->drivers;
+    LogConnectionInfo(snapshot);
 
-    switch (status)
+    switch (snapshot.status)
     {
     case ConnectionStatus::IN_SESSION:
     {
         if (!sessionDrivers.empty())
         {
-            UpdateWithRealData(sessionDrivers);
+            UpdateWithRealData(snapshot);
         }
         else
         {
@@ -109,10 +222,9 @@ void iRacingReputationApp::HandleConnectionStatus(ConnectionStatus status)
 
     case ConnectionStatus::CONNECTED:
     {
-        bool isInSession = m_iracingConnection->IsInSession();
-        if (isInSession && !sessionDrivers.empty())
+        if (snapshot.inSession && !sessionDrivers.empty())
         {
-            UpdateWithRealData(sessionDrivers);
+            UpdateWithRealData(snapshot);
         }
         else
         {
@@ -129,9 +241,11 @@ void iRacingReputationApp::HandleConnectionStatus(ConnectionStatus status)
     }
 }
 
-void iRacingReputationApp::UpdateWithRealData(const std::vector<DriverData> &drivers)
+void iRacingReputationApp::UpdateWithRealData(const TelemetrySnapshot &snapshot)
 {
-    m_driverTagWindow->UpdateSessionData(drivers);
+    // La ventana sólo copia el roster cuando cambia de versión; la posición viene del último tick
+    ReadLatestTick();
+    m_driverTagWindow->UpdateSessionData(snapshot.roster, m_lastTick.frame);
 }
 
 void iRacingReputationApp::FallbackToMockIfNeeded()
@@ -147,11 +261,11 @@ void iRacingReputationApp::FallbackToMockIfNeeded()
     }
 }
 
-void iRacingReputationApp::LogConnectionInfo(ConnectionStatus status, const std::vector<DriverData> &drivers) const
+void iRacingReputationApp::LogConnectionInfo(const TelemetrySnapshot &snapshot) const
 {
-    const size_t driverCount = drivers.size();
+    const size_t driverCount = snapshot.roster->drivers.size();
 
-    switch (status)
+    switch (snapshot.status)
     {
     case ConnectionStatus::IN_SESSION:
         Logger::Info("🏁 SESIÓN ACTIVA - Usando datos REALES de iRacing - " +
@@ -160,8 +274,7 @@ void iRacingReputationApp::LogConnectionInfo(ConnectionStatus status, const std:
 
     case ConnectionStatus::CONNECTED:
     {
-        bool isInSession = m_iracingConnection->IsInSession();
-        Logger::Info("iRacing conectado - En sesión: " + std::string(isInSession ? "SÍ" : "NO") +
+        Logger::Info("iRacing conectado - En sesión: " + std::string(snapshot.inSession ? "SÍ" : "NO") +
                      " - Pilotos: " + std::to_string(driverCount));
         break;
     }
@@ -198,21 +311,35 @@ void iRacingReputationApp::Run()
         }
 
         // Detectar proximidad y mostrar overlay si corresponde
-        int playerCarIdx = m_iracingConnection->GetPlayerCarIdx();
-        const auto &drivers = m_iracingConnection->GetSessionDrivers();
+        auto snapshot = m_telemetryReader->GetSnapshot();
+        ReadLatestTick();
+        TrackEncounters(*snapshot);
+        const auto &drivers = snapshot->roster->drivers;
         const auto &reputations = m_driverTagWindow->GetDriverReputations();
         if (drivers.empty() || reputations.empty())
         {
-            std::vector<TagInfo> tags;
-            TagInfo tag1;
-            tag1.name = "AGGRESSIVE";
-            tag1.color = ImVec4(1, 0.5, 0, 1);
-            tags.push_back(tag1);
-            overlayManager.ShowOverlay(99, "Piloto Test", tags, 5.0f);
+            // Advertencia de prueba para ver el overlay sin datos reales
+            static DriverData testDriver = []
+            {
+                DriverData d;
+                d.carIdx = 99;
+                d.customerId = 99;
+                d.displayName = "Piloto Test";
+                d.carNumber = "99";
+                return d;
+            }();
+            static DriverReputation testReputation = []
+            {
+                DriverReputation r;
+                r.AddBehavior(DriverFlags::AGGRESSIVE);
+                return r;
+            }();
+            const ProximityCandidate testCandidate = {&testDriver, &testReputation, 0.8f, true};
+            overlayManager.UpdateWarnings(&testCandidate, 1, 5.0f);
         }
-        else
+        else if (snapshot->status != ConnectionStatus::DISCONNECTED)
         {
-            proximityLogic.CheckAndShowOverlay(playerCarIdx, drivers, reputations, 10.0f);
+            proximityLogic.CheckAndShowOverlay(m_lastTick.playerCarIdx, *snapshot->roster, m_lastTick.frame, reputations, 10.0f);
         }
 
         // Actualizar y renderizar ventana
@@ -228,6 +355,9 @@ void iRacingReputationApp::Run()
         }
 
         m_driverTagWindow->Render();
-        std::this_thread::sleep_for(AppConfig::FRAME_TIME);
+
+        // Fuera de sesión y con la ventana en segundo plano no hay nada que refrescar a 60 FPS
+        const bool idle = snapshot->status != ConnectionStatus::IN_SESSION && !m_driverTagWindow->IsForeground();
+        std::this_thread::sleep_for(idle ? AppConfig::IDLE_FRAME_TIME : AppConfig::FRAME_TIME);
     }
 }
@@ -12,20 +12,27 @@ Aplicación principal del sistema de reputación de pilotos
 
 #include "Utils/Logging/Logger.h"
 #include "UI/DriverTagWindow.h"
-#include "Core/IRacingSDK/IRacingConnection.h"
+#include "Core/IRacingSDK/TelemetryReader.h"
+#include "Core/Analysis/EncounterTracker.h"
 #include "AppConfig.h"
 
 /**
  * @brief Clase principal de la aplicación iRacing Reputation System
  *
- * Maneja la lógica principal, actualización de datos y renderizado
+ * Maneja la lógica principal, actualización de datos y renderizado. La lectura
+ * del SDK ocurre en TelemetryReader; el bucle de UI sólo consume snapshots de
+ * sesión y el último tick del anillo de frames.
  */
 class iRacingReputationApp
 {
 public:
-    iRacingReputationApp();
+    // source: fuente de telemetría (nullptr = simulador en vivo, o un .ibt con ReplayTelemetrySource)
+    explicit iRacingReputationApp(std::unique_ptr<ITelemetrySource> source = nullptr);
     ~iRacingReputationApp();
 
+    // Grabar la telemetría en un .ircap (antes de Run())
+    void SetCapturePath(const std::string &path) { m_telemetryReader->SetCapturePath(path); }
+
     // Métodos principales
     bool Initialize();
     void Run();
@@ -33,16 +40,40 @@ public:
 private:
     // Componentes principales
     std::unique_ptr<DriverTagWindow> m_driverTagWindow;
-    std::unique_ptr<IRacingConnection> m_iracingConnection;
+    std::unique_ptr<TelemetryReader> m_telemetryReader;
+
+    // Último tick leído del anillo; el bucle de UI va a ~60 FPS y se salta los intermedios
+    TelemetryFrameRing::Cursor m_tickCursor;
+    TelemetryTick m_lastTick;
+    AcquisitionStats m_acquisitionStats; // Copia para la vista Diagnóstico
+
+    // Encuentros en vivo: cursor propio que lee todos los ticks en orden (no sólo el último)
+    EncounterTracker m_encounters;
+    TelemetryFrameRing::Cursor m_encounterCursor;
+    TelemetryTick m_encounterTick;
+    std::string m_encounterSource; // Seguimiento actual en proximity_history/session_windows
+    int m_encounterSubSessionId = 0;
+    int m_encounterCustomerId = 0;
+    std::vector<SessionWindow> m_encounterWindows;  // Tramos vistos en este seguimiento, uno por SessionNum
+    bool m_encounterWindowsChanged = false;         // Ampliados desde que se pasaron al lote
+    std::vector<EncounterSummary> m_encounterBatch; // Lote recogido y aún sin guardar
+    std::vector<SessionWindow> m_encounterBatchWindows; // Tramos que cubre el lote
+    std::string m_encounterBatchSource;             // Seguimiento del lote (puede no ser ya el actual)
+    std::vector<EncounterSummary> m_encounterTaken;
+    std::chrono::steady_clock::time_point m_lastEncounterFlush;
 
     // Control de ejecución
     std::atomic<bool> m_running{false};
 
     // Métodos privados
     void UpdateDriverData();
+    void ReadLatestTick();
+    void TrackEncounters(const TelemetrySnapshot &snapshot);
+    void ExtendEncounterWindow(int sessionNum, double sessionTime);
+    void FlushEncounters(bool force);
     bool ShouldUseMockData() const;
-    void HandleConnectionStatus(ConnectionStatus status);
-    void UpdateWithRealData(const std::vector<DriverData> &drivers);
+    void HandleConnectionStatus(const TelemetrySnapshot &snapshot);
+    void UpdateWithRealData(const TelemetrySnapshot &snapshot);
     void FallbackToMockIfNeeded();
-    void LogConnectionInfo(ConnectionStatus status, const std::vector<DriverData> &drivers) const;
+    void LogConnectionInfo(const TelemetrySnapshot &snapshot) const;
 };
@@ -0,0 +1,347 @@
+/*
+MIT License - iRacing Reputation System
+Lectura de capturas compactas de telemetría - Implementaciones
+*/
+
+#include "CaptureReader.h"
+#include "../IRacingSDK/irsdk_platform.h"
+#include "../IRacingSDK/irsdk_diskclient.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using namespace TelemetryCapture;
+
+CaptureReader::~CaptureReader()
+{
+    Close();
+}
+
+bool CaptureReader::Open(const std::string &path)
+{
+    Close();
+
+    m_base = irsdkPlatform_mapFile(path.c_str(), &m_size);
+    if (!m_base)
+    {
+        Logger::Error("Captura: no se pudo abrir " + path);
+        return false;
+    }
+
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(m_base);
+    const uint8_t *end = p + m_size;
+    uint64_t version = 0, tickRate = 0, keyframeInterval = 0, startDate = 0, numVars = 0;
+    bool valid = m_size > sizeof(MAGIC) && memcmp(p, MAGIC, sizeof(MAGIC)) == 0;
+    p += sizeof(MAGIC);
+    valid = valid && (p = ReadVarint(p, end, version)) && version == VERSION;
+    valid = valid && (p = ReadVarint(p, end, tickRate)) && (p = ReadVarint(p, end, keyframeInterval)) &&
+            (p = ReadVarint(p, end, startDate)) && (p = ReadVarint(p, end, numVars));
+    valid = valid && numVars > 0 && numVars <= static_cast<uint64_t>(end - p) / sizeof(irsdk_varHeader);
+    if (!valid)
+    {
+        Logger::Error("Captura no válida: " + path);
+        Close();
+        return false;
+    }
+
+    m_headers.resize(static_cast<size_t>(numVars));
+    memcpy(m_headers.data(), p, m_headers.size() * sizeof(irsdk_varHeader));
+    p += m_headers.size() * sizeof(irsdk_varHeader);
+
+    int bufLen = 0;
+    for (const auto &header : m_headers)
+    {
+        if (header.type < 0 || header.type >= irsdk_ETCount || header.count <= 0 || header.offset != bufLen)
+        {
+            Logger::Error("Captura con cabeceras no válidas: " + path);
+            Close();
+            return false;
+        }
+        m_columns.push_back({header.offset, irsdk_VarTypeBytes[header.type], header.count});
+        bufLen += irsdk_VarTypeBytes[header.type] * header.count;
+    }
+
+    m_tickRate = static_cast<int>(tickRate);
+    m_startDate = static_cast<std::time_t>(startDate);
+    m_row.assign(bufLen, 0);
+    m_dataStart = p - reinterpret_cast<const uint8_t *>(m_base);
+    m_dataEnd = m_size;
+
+    if (!ReadIndex())
+    {
+        Logger::Warning("Captura sin índice (¿grabación interrumpida?), recorriendo registros: " + path);
+        ScanIndex();
+    }
+
+    m_cursor = m_dataStart;
+    m_tick = -1;
+    return true;
+}
+
+void CaptureReader::Close()
+{
+    if (m_base)
+        irsdkPlatform_unmapFile(m_base, m_size);
+
+    m_base = nullptr;
+    m_size = 0;
+    m_headers.clear();
+    m_columns.clear();
+    m_keyframes.clear();
+    m_row.clear();
+    m_sessionInfo.clear();
+    m_tickCount = 0;
+    m_tick = -1;
+}
+
+bool CaptureReader::ReadRecord(uint64_t offset, uint8_t &tag, const uint8_t *&payload, size_t &len, uint64_t &next) const
+{
+    if (offset >= m_dataEnd)
+        return false;
+
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(m_base) + offset;
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(m_base) + m_dataEnd;
+    tag = *p++;
+
+    uint64_t length;
+    p = ReadVarint(p, end, length);
+    if (!p || length > static_cast<uint64_t>(end - p))
+        return false;
+
+    payload = p;
+    len = static_cast<size_t>(length);
+    next = (p - reinterpret_cast<const uint8_t *>(m_base)) + length;
+    return true;
+}
+
+bool CaptureReader::ReadIndex()
+{
+    if (m_size < m_dataStart + FOOTER_SIZE)
+        return false;
+
+    const char *footer = m_base + m_size - FOOTER_SIZE;
+    if (memcmp(footer + sizeof(uint64_t), INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+        return false;
+
+    uint64_t indexOffset;
+    memcpy(&indexOffset, footer, sizeof(indexOffset));
+    if (indexOffset < m_dataStart || indexOffset >= m_size - FOOTER_SIZE)
+        return false;
+
+    m_dataEnd = m_size - FOOTER_SIZE;
+    uint8_t tag;
+    const uint8_t *payload;
+    size_t len;
+    uint64_t next;
+    if (!ReadRecord(indexOffset, tag, payload, len, next) || tag != TAG_INDEX)
+    {
+        m_dataEnd = m_size;
+        return false;
+    }
+
+    const uint8_t *p = payload;
+    const uint8_t *end = payload + len;
+    uint64_t tickCount, keyframes;
+    if (!(p = ReadVarint(p, end, tickCount)) || !(p = ReadVarint(p, end, keyframes)))
+        return false;
+
+    for (uint64_t k = 0; k < keyframes; ++k)
+    {
+        uint64_t tick, offset, sessionOffset;
+        if (!(p = ReadVarint(p, end, tick)) || !(p = ReadVarint(p, end, offset)) || !(p = ReadVarint(p, end, sessionOffset)))
+        {
+            m_keyframes.clear();
+            m_dataEnd = m_size;
+            return false;
+        }
+        m_keyframes.push_back({static_cast<int>(tick), offset, sessionOffset});
+    }
+
+    m_tickCount = static_cast<int>(tickCount);
+    m_dataEnd = indexOffset;
+    return true;
+}
+
+void CaptureReader::ScanIndex()
+{
+    m_keyframes.clear();
+    m_tickCount = 0;
+
+    uint64_t offset = m_dataStart;
+    uint64_t sessionOffset = 0;
+    uint8_t tag;
+    const uint8_t *payload;
+    size_t len;
+    uint64_t next;
+    while (ReadRecord(offset, tag, payload, len, next))
+    {
+        if (tag == TAG_SESSION)
+            sessionOffset = offset;
+        else if (tag == TAG_KEYFRAME)
+            m_keyframes.push_back({m_tickCount, offset, sessionOffset});
+
+        if (tag == TAG_KEYFRAME || tag == TAG_DELTA)
+            m_tickCount++;
+        offset = next;
+    }
+
+    // Un registro cortado al final no se lee
+    m_dataEnd = offset;
+}
+
+bool CaptureReader::Next()
+{
+    uint8_t tag;
+    const uint8_t *payload;
+    size_t len;
+    uint64_t next;
+    while (ReadRecord(m_cursor, tag, payload, len, next))
+    {
+        m_cursor = next;
+        switch (tag)
+        {
+        case TAG_SESSION:
+            m_sessionInfo.assign(reinterpret_cast<const char *>(payload), len);
+            break;
+        case TAG_KEYFRAME:
+            if (len != m_row.size())
+                return false;
+            memcpy(m_row.data(), payload, len);
+            m_tick++;
+            return true;
+        case TAG_DELTA:
+            // Un delta antes del primer keyframe no tiene base
+            if (m_tick < 0 || !ApplyDelta(payload, len))
+                return false;
+            m_tick++;
+            return true;
+        default:
+            break; // Registros desconocidos se saltan
+        }
+    }
+    return false;
+}
+
+bool CaptureReader::ApplyDelta(const uint8_t *payload, size_t len)
+{
+    const uint8_t *p = payload;
+    const uint8_t *end = payload + len;
+    const size_t varBitmapBytes = (m_columns.size() + 7) / 8;
+    if (len < varBitmapBytes)
+        return false;
+
+    const uint8_t *varBitmap = p;
+    p += varBitmapBytes;
+
+    for (size_t v = 0; v < m_columns.size(); ++v)
+    {
+        if (!(varBitmap[v >> 3] & (1 << (v & 7))))
+            continue;
+
+        const Column &column = m_columns[v];
+        const uint8_t *elemBitmap = nullptr;
+        if (column.count > 1)
+        {
+            const size_t elemBitmapBytes = (column.count + 7) / 8;
+            if (static_cast<size_t>(end - p) < elemBitmapBytes)
+                return false;
+            elemBitmap = p;
+            p += elemBitmapBytes;
+        }
+
+        for (int e = 0; e < column.count; ++e)
+        {
+            if (elemBitmap && !(elemBitmap[e >> 3] & (1 << (e & 7))))
+                continue;
+
+            uint64_t delta;
+            if (!(p = ReadVarint(p, end, delta)))
+                return false;
+
+            char *value = m_row.data() + column.offset + e * column.width;
+            StoreBits(value, column.width, LoadBits(value, column.width) + static_cast<uint64_t>(UnZigZag(delta)));
+        }
+    }
+    return p == end;
+}
+
+bool CaptureReader::Seek(int tick)
+{
+    if (!m_base || tick < 0 || tick > m_tickCount || m_keyframes.empty())
+        return false;
+
+    // Último keyframe en o antes del tick pedido
+    auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), tick,
+                               [](int t, const Keyframe &k)
+                               { return t < k.tick; });
+    if (it == m_keyframes.begin())
+        return false;
+    --it;
+
+    // Recuperar el YAML vigente en ese keyframe
+    m_sessionInfo.clear();
+    uint8_t tag;
+    const uint8_t *payload;
+    size_t len;
+    uint64_t next;
+    if (it->sessionOffset >= m_dataStart && ReadRecord(it->sessionOffset, tag, payload, len, next) && tag == TAG_SESSION)
+        m_sessionInfo.assign(reinterpret_cast<const char *>(payload), len);
+
+    m_cursor = it->offset;
+    m_tick = it->tick - 1;
+    while (m_tick < tick - 1)
+    {
+        if (!Next())
+            return false;
+    }
+    return true;
+}
+
+bool CaptureReader::ExportIbt(const std::string &path)
+{
+    if (!m_base)
+        return false;
+
+    // El .ibt lleva un único YAML: el último de la captura
+    std::string lastSession;
+    uint64_t offset = m_dataStart;
+    uint8_t tag;
+    const uint8_t *payload;
+    size_t len;
+    uint64_t next;
+    while (ReadRecord(offset, tag, payload, len, next))
+    {
+        if (tag == TAG_SESSION)
+            lastSession.assign(reinterpret_cast<const char *>(payload), len);
+        offset = next;
+    }
+
+    // irsdkDiskWriter lleva buffers estáticos de más de 1 MB
+    auto writer = std::make_unique<irsdkDiskWriter>();
+    if (!writer->openFile(path.c_str()))
+    {
+        Logger::Error("No se pudo crear el .ibt: " + path);
+        return false;
+    }
+
+    for (const auto &header : m_headers)
+        writer->addNewVariable(header.name, header.desc, header.unit, static_cast<irsdk_VarType>(header.type), header.count);
+    writer->setTickRate(m_tickRate);
+    writer->setSessionStr(lastSession.c_str());
+    writer->setSessionStartDate(m_startDate);
+    writer->finalizeHeader();
+
+    // addNewVariable asigna los offsets igual que la fila compacta
+    Seek(0);
+    while (Next())
+    {
+        memcpy(writer->getVarBuf(), m_row.data(), m_row.size());
+        writer->writeLine();
+    }
+
+    const int written = writer->getDataCount();
+    writer->closeFile();
+    Logger::InfoF("Captura exportada a %s: %d registros", path.c_str(), written);
+    return written == m_tickCount;
+}
@@ -0,0 +1,94 @@
+/*
+MIT License - iRacing Reputation System
+Lectura de capturas compactas de telemetría (.ircap)
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "TelemetryCapture.h"
+#include "../IRacingSDK/irsdk_defines.h"
+
+/**
+ * @brief Reconstruye fila a fila una captura grabada con CaptureWriter
+ *
+ * El archivo se mapea en memoria. Next() aplica el siguiente delta sobre la fila
+ * actual; Seek() salta al keyframe anterior al tick pedido y avanza desde ahí.
+ * ExportIbt() vuelca la captura a un .ibt que irsdkDiskClient puede leer.
+ */
+class CaptureReader
+{
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader &) = delete;
+    CaptureReader &operator=(const CaptureReader &) = delete;
+
+    bool Open(const std::string &path);
+    void Close();
+    bool IsOpen() const { return m_base != nullptr; }
+
+    const irsdk_varHeader *GetVarHeaders() const { return m_headers.data(); }
+    int GetNumVars() const { return static_cast<int>(m_headers.size()); }
+    int GetBufLen() const { return static_cast<int>(m_row.size()); }
+    int GetTickRate() const { return m_tickRate; }
+    std::time_t GetStartDate() const { return m_startDate; }
+    const std::string &GetSessionInfo() const { return m_sessionInfo; } // El vigente en el tick actual
+
+    int GetTickCount() const { return m_tickCount; }
+    int GetTickIndex() const { return m_tick; } // -1 antes del primer Next()
+
+    // Avanza un tick. false al final de la captura o si un registro está corrupto
+    bool Next();
+    // El siguiente Next() devolverá el tick indicado
+    bool Seek(int tick);
+
+    // Fila actual, con el layout de GetVarHeaders()
+    const char *GetRow() const { return m_row.data(); }
+
+    bool ExportIbt(const std::string &path);
+
+private:
+    struct Keyframe
+    {
+        int tick;
+        uint64_t offset;
+        uint64_t sessionOffset;
+    };
+
+    struct Column
+    {
+        int offset;
+        int width;
+        int count;
+    };
+
+    bool ReadIndex();
+    void ScanIndex();
+    // Lee el registro en offset; devuelve false si no cabe en el archivo
+    bool ReadRecord(uint64_t offset, uint8_t &tag, const uint8_t *&payload, size_t &len, uint64_t &next) const;
+    bool ApplyDelta(const uint8_t *payload, size_t len);
+
+    const char *m_base = nullptr;
+    size_t m_size = 0;
+    uint64_t m_dataStart = 0; // Primer registro
+    uint64_t m_dataEnd = 0;   // Fin de los registros (índice o fin de archivo)
+
+    std::vector<irsdk_varHeader> m_headers;
+    std::vector<Column> m_columns;
+    std::vector<Keyframe> m_keyframes;
+    int m_tickRate = 0;
+    std::time_t m_startDate = 0;
+    int m_tickCount = 0;
+
+    std::vector<char> m_row;
+    std::string m_sessionInfo;
+    uint64_t m_cursor = 0; // Siguiente registro a leer
+    int m_tick = -1;
+};
@@ -0,0 +1,223 @@
+/*
+MIT License - iRacing Reputation System
+Grabación de telemetría en formato compacto - Implementaciones
+*/
+
+#include "CaptureWriter.h"
+#include "../../Utils/Logging/Logger.h"
+#include <cstring>
+#include <ctime>
+
+using namespace TelemetryCapture;
+
+CaptureWriter::~CaptureWriter()
+{
+    Close();
+}
+
+bool CaptureWriter::Open(const std::string &path, const irsdk_varHeader *varHeaders, int numVars,
+                         const std::vector<std::string> &varNames, int tickRate, const char *sessionInfo,
+                         int keyframeInterval)
+{
+    Close();
+
+    // Fila compacta: las variables capturadas, contiguas y en el orden pedido
+    std::vector<irsdk_varHeader> headers;
+    m_columns.clear();
+    m_bufLen = 0;
+    for (const auto &name : varNames)
+    {
+        for (int i = 0; i < numVars; ++i)
+        {
+            const irsdk_varHeader &src = varHeaders[i];
+            if (strncmp(src.name, name.c_str(), IRSDK_MAX_STRING) != 0)
+                continue;
+
+            irsdk_varHeader dst = src;
+            dst.offset = m_bufLen;
+            headers.push_back(dst);
+
+            Column column;
+            column.srcOffset = src.offset;
+            column.dstOffset = m_bufLen;
+            column.width = irsdk_VarTypeBytes[src.type];
+            column.count = src.count;
+            m_columns.push_back(column);
+
+            m_bufLen += column.width * column.count;
+            break;
+        }
+    }
+
+    if (m_columns.empty())
+    {
+        Logger::Error("Captura: ninguna de las variables pedidas está en la fuente");
+        return false;
+    }
+
+    m_file = fopen(path.c_str(), "wb");
+    if (!m_file)
+    {
+        Logger::Error("Captura: no se pudo crear " + path);
+        return false;
+    }
+    setvbuf(m_file, nullptr, _IOFBF, 1 << 16);
+
+    m_keyframeInterval = keyframeInterval > 0 ? keyframeInterval : DEFAULT_KEYFRAME_INTERVAL;
+    m_cur.assign(m_bufLen, 0);
+    m_prev.assign(m_bufLen, 0);
+    m_keyframes.clear();
+    m_keyframes.reserve(MAX_INDEX_ENTRIES);
+    m_indexStride = 1;
+    m_ticks = 0;
+    m_bytesWritten = 0;
+    m_lastSessionOffset = 0;
+
+    // Peor caso de un delta: todos los bitmaps y un varint máximo por elemento
+    size_t maxPayload = (m_columns.size() + 7) / 8;
+    for (const auto &column : m_columns)
+        maxPayload += (column.count > 1 ? (column.count + 7) / 8 : 0) + static_cast<size_t>(column.count) * MAX_VARINT_BYTES;
+    m_payload.assign(maxPayload, 0);
+
+    uint8_t header[8 + 5 * MAX_VARINT_BYTES];
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    uint8_t *p = header + sizeof(MAGIC);
+    p = WriteVarint(p, VERSION);
+    p = WriteVarint(p, static_cast<uint64_t>(tickRate));
+    p = WriteVarint(p, static_cast<uint64_t>(m_keyframeInterval));
+    p = WriteVarint(p, static_cast<uint64_t>(std::time(nullptr)));
+    p = WriteVarint(p, headers.size());
+    fwrite(header, 1, p - header, m_file);
+    fwrite(headers.data(), sizeof(irsdk_varHeader), headers.size(), m_file);
+    m_bytesWritten = (p - header) + headers.size() * sizeof(irsdk_varHeader);
+
+    WriteSessionInfo(sessionInfo);
+
+    Logger::InfoF("Captura iniciada: %s (%d variables, %d bytes por fila)", path.c_str(),
+                  static_cast<int>(m_columns.size()), m_bufLen);
+    return true;
+}
+
+void CaptureWriter::Close()
+{
+    if (!m_file)
+        return;
+
+    // Índice de keyframes y pie para que el lector pueda saltar sin recorrer el archivo
+    const uint64_t indexOffset = m_bytesWritten;
+    std::vector<uint8_t> index(2 * MAX_VARINT_BYTES + m_keyframes.size() * 3 * MAX_VARINT_BYTES);
+    uint8_t *p = WriteVarint(index.data(), static_cast<uint64_t>(m_ticks));
+    p = WriteVarint(p, m_keyframes.size());
+    for (const auto &keyframe : m_keyframes)
+    {
+        p = WriteVarint(p, static_cast<uint64_t>(keyframe.tick));
+        p = WriteVarint(p, keyframe.offset);
+        p = WriteVarint(p, keyframe.sessionOffset);
+    }
+    WriteRecord(TAG_INDEX, index.data(), p - index.data());
+
+    fwrite(&indexOffset, sizeof(indexOffset), 1, m_file);
+    fwrite(INDEX_MAGIC, 1, sizeof(INDEX_MAGIC), m_file);
+    m_bytesWritten += FOOTER_SIZE;
+
+    fclose(m_file);
+    m_file = nullptr;
+
+    Logger::InfoF("Captura cerrada: %d ticks, %llu bytes (%.1f%% de las filas completas)", m_ticks,
+                  static_cast<unsigned long long>(m_bytesWritten),
+                  GetRawBytes() > 0 ? 100.0 * m_bytesWritten / GetRawBytes() : 0.0);
+}
+
+void CaptureWriter::WriteSessionInfo(const char *sessionInfo)
+{
+    if (!m_file || !sessionInfo)
+        return;
+
+    m_lastSessionOffset = m_bytesWritten;
+    WriteRecord(TAG_SESSION, reinterpret_cast<const uint8_t *>(sessionInfo), strlen(sessionInfo));
+}
+
+void CaptureWriter::WriteTick(const char *row)
+{
+    if (!m_file || !row)
+        return;
+
+    for (const auto &column : m_columns)
+        memcpy(m_cur.data() + column.dstOffset, row + column.srcOffset, static_cast<size_t>(column.width) * column.count);
+
+    if (m_ticks % m_keyframeInterval == 0)
+    {
+        const int keyframe = m_ticks / m_keyframeInterval;
+        if (keyframe % m_indexStride == 0 && m_keyframes.size() == MAX_INDEX_ENTRIES)
+            ThinIndex();
+        if (keyframe % m_indexStride == 0)
+            m_keyframes.push_back({m_ticks, m_bytesWritten, m_lastSessionOffset});
+        WriteRecord(TAG_KEYFRAME, reinterpret_cast<const uint8_t *>(m_cur.data()), m_cur.size());
+    }
+    else
+    {
+        WriteRecord(TAG_DELTA, m_payload.data(), EncodeDelta());
+    }
+
+    m_cur.swap(m_prev);
+    m_ticks++;
+}
+
+void CaptureWriter::ThinIndex()
+{
+    // Las entradas son los keyframes 0, s, 2s...: quedarse con las pares deja 0, 2s, 4s...
+    size_t kept = 0;
+    for (size_t i = 0; i < m_keyframes.size(); i += 2)
+        m_keyframes[kept++] = m_keyframes[i];
+    m_keyframes.resize(kept);
+    m_indexStride *= 2;
+}
+
+size_t CaptureWriter::EncodeDelta()
+{
+    uint8_t *varBitmap = m_payload.data();
+    const size_t varBitmapBytes = (m_columns.size() + 7) / 8;
+    memset(varBitmap, 0, varBitmapBytes);
+    uint8_t *p = varBitmap + varBitmapBytes;
+
+    for (size_t v = 0; v < m_columns.size(); ++v)
+    {
+        const Column &column = m_columns[v];
+        const char *cur = m_cur.data() + column.dstOffset;
+        const char *prev = m_prev.data() + column.dstOffset;
+        if (memcmp(cur, prev, static_cast<size_t>(column.width) * column.count) == 0)
+            continue;
+
+        varBitmap[v >> 3] |= static_cast<uint8_t>(1 << (v & 7));
+
+        uint8_t *elemBitmap = nullptr;
+        if (column.count > 1)
+        {
+            elemBitmap = p;
+            memset(elemBitmap, 0, (column.count + 7) / 8);
+            p += (column.count + 7) / 8;
+        }
+
+        for (int e = 0; e < column.count; ++e)
+        {
+            const uint64_t a = LoadBits(cur + e * column.width, column.width);
+            const uint64_t b = LoadBits(prev + e * column.width, column.width);
+            if (a == b)
+                continue;
+            if (elemBitmap)
+                elemBitmap[e >> 3] |= static_cast<uint8_t>(1 << (e & 7));
+            p = WriteVarint(p, ZigZag(DeltaBits(a, b, column.width)));
+        }
+    }
+    return p - m_payload.data();
+}
+
+void CaptureWriter::WriteRecord(uint8_t tag, const uint8_t *payload, size_t len)
+{
+    uint8_t header[1 + MAX_VARINT_BYTES];
+    header[0] = tag;
+    uint8_t *p = WriteVarint(header + 1, len);
+    fwrite(header, 1, p - header, m_file);
+    fwrite(payload, 1, len, m_file);
+    m_bytesWritten += (p - header) + len;
+}
@@ -0,0 +1,91 @@
+/*
+MIT License - iRacing Reputation System
+Grabación de telemetría en formato compacto (.ircap)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "TelemetryCapture.h"
+#include "../IRacingSDK/irsdk_defines.h"
+
+/**
+ * @brief Graba las variables elegidas tick a tick, codificando sólo lo que cambia
+ *
+ * Open() resuelve las variables contra las cabeceras de la fuente y reserva todos
+ * los buffers, incluido el índice de keyframes (MAX_INDEX_ENTRIES entradas);
+ * WriteTick() no reserva memoria: copia las variables a una fila compacta, la
+ * compara con la anterior y escribe el delta (o un keyframe cada keyframeInterval
+ * ticks) en un único registro. Pensado para llamarse desde el hilo lector con la
+ * fila del SDK.
+ *
+ * Cuando el índice se llena se descarta una entrada de cada dos y a partir de ahí
+ * se indexa uno de cada dos keyframes: el índice cubre siempre toda la grabación y
+ * Seek() avanza como mucho unos keyframes más desde la entrada anterior.
+ */
+class CaptureWriter
+{
+public:
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 600; // 10 s a 60 Hz
+    static constexpr size_t MAX_INDEX_ENTRIES = 4096;     // ~11 h a 60 Hz antes de empezar a aclarar el índice
+
+    CaptureWriter() = default;
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter &) = delete;
+    CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+    // Las variables de varNames que no estén en varHeaders se omiten
+    bool Open(const std::string &path, const irsdk_varHeader *varHeaders, int numVars,
+              const std::vector<std::string> &varNames, int tickRate, const char *sessionInfo,
+              int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    // row: fila completa con el layout de las cabeceras pasadas a Open()
+    void WriteTick(const char *row);
+    void WriteSessionInfo(const char *sessionInfo);
+
+    int GetTickCount() const { return m_ticks; }
+    uint64_t GetBytesWritten() const { return m_bytesWritten; }
+    uint64_t GetRawBytes() const { return static_cast<uint64_t>(m_ticks) * m_bufLen; } // Lo que ocuparían filas completas
+
+private:
+    struct Column
+    {
+        int srcOffset;
+        int dstOffset;
+        int width; // Bytes por elemento
+        int count;
+    };
+
+    struct Keyframe
+    {
+        int tick;
+        uint64_t offset;
+        uint64_t sessionOffset;
+    };
+
+    void WriteRecord(uint8_t tag, const uint8_t *payload, size_t len);
+    size_t EncodeDelta();
+    void ThinIndex();
+
+    FILE *m_file = nullptr;
+    std::vector<Column> m_columns;
+    int m_bufLen = 0;
+    int m_keyframeInterval = DEFAULT_KEYFRAME_INTERVAL;
+
+    std::vector<char> m_cur;
+    std::vector<char> m_prev;
+    std::vector<uint8_t> m_payload; // Tamaño máximo de un delta, reservado en Open()
+    std::vector<Keyframe> m_keyframes; // Capacidad fija, MAX_INDEX_ENTRIES
+    int m_indexStride = 1;             // Keyframes escritos por entrada del índice
+
+    int m_ticks = 0;
+    uint64_t m_bytesWritten = 0;
+    uint64_t m_lastSessionOffset = 0;
+};
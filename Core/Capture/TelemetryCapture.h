@@ -0,0 +1,140 @@
+/*
+MIT License - iRacing Reputation System
+Formato de captura compacta de telemetría (.ircap)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+Archivo .ircap:
+
+    Cabecera   MAGIC[8], luego varints: VERSION, tickRate, keyframeInterval, fecha de
+               inicio (time_t), numVars, y numVars x irsdk_varHeader con los offsets de la fila compacta
+               (sólo las variables capturadas, contiguas en el orden dado).
+    Registros  tag (1 byte) + varint longitud + contenido:
+                 KEYFRAME  fila compacta completa, tal cual (punto de salto)
+                 DELTA     bitmap de variables cambiadas; por cada una, bitmap de
+                           elementos cambiados (si es array) y un varint zigzag por
+                           elemento con la diferencia respecto al tick anterior,
+                           tomando los bits del valor como entero de su anchura
+                 SESSION   nuevo YAML de sesión
+                 INDEX     al cerrar: nº de ticks, nº de keyframes y por cada uno
+                           (tick, offset, offset del último SESSION anterior)
+    Pie        offset del INDEX (uint64) + INDEX_MAGIC[8]. Si falta (captura
+               cortada), el lector reconstruye el índice recorriendo los registros.
+
+Un valor que no cambia no ocupa nada y una variable que no cambia, un bit.
+*/
+
+namespace TelemetryCapture
+{
+    constexpr char MAGIC[8] = {'I', 'R', 'C', 'A', 'P', '\0', '\0', '\1'};
+    constexpr char INDEX_MAGIC[8] = {'I', 'R', 'C', 'A', 'P', 'I', 'D', 'X'};
+    constexpr int VERSION = 1;
+    constexpr int FOOTER_SIZE = 16;
+
+    enum RecordTag : uint8_t
+    {
+        TAG_KEYFRAME = 'K',
+        TAG_DELTA = 'D',
+        TAG_SESSION = 'S',
+        TAG_INDEX = 'I',
+    };
+
+    // Bytes máximos de un varint de 64 bits
+    constexpr int MAX_VARINT_BYTES = 10;
+
+    inline uint64_t ZigZag(int64_t v)
+    {
+        return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+    inline int64_t UnZigZag(uint64_t v)
+    {
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    inline uint8_t *WriteVarint(uint8_t *out, uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            *out++ = static_cast<uint8_t>(v | 0x80);
+            v >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(v);
+        return out;
+    }
+
+    // Devuelve nullptr si el varint no termina antes de end
+    inline const uint8_t *ReadVarint(const uint8_t *in, const uint8_t *end, uint64_t &v)
+    {
+        v = 0;
+        for (int shift = 0; in < end && shift < 64; shift += 7)
+        {
+            uint8_t byte = *in++;
+            v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return in;
+        }
+        return nullptr;
+    }
+
+    // Los valores se comparan y restan como enteros sin signo de su anchura (1, 4 u 8 bytes)
+    inline uint64_t LoadBits(const char *p, int width)
+    {
+        switch (width)
+        {
+        case 1:
+            return static_cast<uint8_t>(*p);
+        case 4:
+        {
+            uint32_t v;
+            memcpy(&v, p, 4);
+            return v;
+        }
+        default:
+        {
+            uint64_t v;
+            memcpy(&v, p, 8);
+            return v;
+        }
+        }
+    }
+
+    inline void StoreBits(char *p, int width, uint64_t v)
+    {
+        switch (width)
+        {
+        case 1:
+            *p = static_cast<char>(v);
+            break;
+        case 4:
+        {
+            uint32_t v32 = static_cast<uint32_t>(v);
+            memcpy(p, &v32, 4);
+            break;
+        }
+        default:
+            memcpy(p, &v, 8);
+            break;
+        }
+    }
+
+    // Diferencia con signo en la anchura del valor, para que un cambio pequeño dé un varint corto
+    inline int64_t DeltaBits(uint64_t cur, uint64_t prev, int width)
+    {
+        switch (width)
+        {
+        case 1:
+            return static_cast<int8_t>(static_cast<uint8_t>(cur - prev));
+        case 4:
+            return static_cast<int32_t>(static_cast<uint32_t>(cur - prev));
+        default:
+            return static_cast<int64_t>(cur - prev);
+        }
+    }
+
+} // namespace TelemetryCapture
@@ -0,0 +1,51 @@
+/*
+MIT License - iRacing Reputation System
+Instrumentación de la adquisición de telemetría - Implementaciones
+*/
+
+#include "AcquisitionStats.h"
+#include "../../Utils/Logging/Logger.h"
+#include <cstdio>
+
+namespace
+{
+    void LogHistogram(const char *name, const HdrHistogram &histogram, double unitScale, const char *unit)
+    {
+        Logger::InfoF("%-10s n=%llu  p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f %s", name,
+                      (unsigned long long)histogram.GetCount(), histogram.ValueAtPercentile(50.0) / unitScale,
+                      histogram.ValueAtPercentile(99.0) / unitScale, histogram.ValueAtPercentile(99.9) / unitScale,
+                      histogram.GetMax() / unitScale, unit);
+    }
+} // namespace
+
+void AcquisitionStats::Log() const
+{
+    Logger::InfoF("Adquisición: %llu ticks a %d Hz, %llu perdidos por lectura lenta, %llu filas rotas",
+                  (unsigned long long)ticks, tickRate, (unsigned long long)droppedTicks,
+                  (unsigned long long)tornReads);
+    LogHistogram("tickGap", tickGap, 1.0, "ticks");
+    LogHistogram("retries", retries, 1.0, "");
+    LogHistogram("copia", copyNs, 1000.0, "us");
+    LogHistogram("latencia", latencyNs, 1000.0, "us");
+}
+
+bool AcquisitionStats::WriteToFile(const std::string &path) const
+{
+    FILE *out = fopen(path.c_str(), "w");
+    if (!out)
+    {
+        Logger::Error("No se pudo escribir " + path);
+        return false;
+    }
+
+    fprintf(out, "# ticks %llu, tickRate %d, perdidos %llu, filas rotas %llu\n\n", (unsigned long long)ticks, tickRate,
+            (unsigned long long)droppedTicks, (unsigned long long)tornReads);
+    tickGap.Write(out, "tickGap (ticks)");
+    retries.Write(out, "retries (reintentos por fila)");
+    copyNs.Write(out, "copy (us)", 1000.0);
+    latencyNs.Write(out, "latency signal->frame (us)", 1000.0);
+    fclose(out);
+
+    Logger::Info("Estadísticas de adquisición guardadas en " + path);
+    return true;
+}
@@ -0,0 +1,43 @@
+/*
+MIT License - iRacing Reputation System
+Instrumentación de la adquisición de telemetría (huecos de ticks, reintentos, copia, latencia)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "../../Utils/Common/HdrHistogram.h"
+
+/**
+ * @brief Histogramas de cada tick leído por IRacingConnection
+ *
+ * - tickGap: diferencia de SessionTick con el tick anterior (1 = ninguno perdido por
+ *   leer despacio).
+ * - retries: copias repetidas porque el simulador reescribió el buffer a mitad de copia.
+ * - copyNs: tiempo de copiar la fila de la memoria compartida.
+ * - latencyNs: de la señal del productor a tener el frame calculado. Sólo donde el
+ *   evento lleva marca de tiempo (POSIX); en Windows queda vacío.
+ *
+ * Las filas perdidas por copia rota no llegan como tick: se cuentan en tornReads.
+ */
+struct AcquisitionStats
+{
+    HdrHistogram tickGap;
+    HdrHistogram retries;
+    HdrHistogram copyNs;
+    HdrHistogram latencyNs;
+    uint64_t ticks = 0;
+    uint64_t droppedTicks = 0; // Suma de (tickGap - 1)
+    uint64_t tornReads = 0;
+    int tickRate = 0;
+
+    void Reset() { *this = AcquisitionStats(); }
+
+    // Resumen de una línea por histograma
+    void Log() const;
+
+    // Vuelca los histogramas en formato .hgrm (texto de HdrHistogram)
+    bool WriteToFile(const std::string &path) const;
+};
@@ -0,0 +1,86 @@
+/*
+MIT License - iRacing Reputation System
+Máquina de estados de la conexión - Implementaciones
+*/
+
+#include "ConnectionStateMachine.h"
+#include "../../Utils/Logging/Logger.h"
+#include <algorithm>
+
+ConnectionStateMachine::ConnectionStateMachine()
+    : m_stateSince(Clock::now()), m_nextProbe(m_stateSince)
+{
+    m_stats[Index(m_state)].entries = 1;
+}
+
+bool ConnectionStateMachine::IsProbeDue(Clock::time_point now, Clock::duration &timeUntilProbe) const
+{
+    if (now >= m_nextProbe)
+        return true;
+
+    timeUntilProbe = m_nextProbe - now;
+    return false;
+}
+
+void ConnectionStateMachine::OnProbeFailed(Clock::time_point now)
+{
+    m_nextProbe = now + std::chrono::milliseconds(m_probeDelayMs);
+    m_probeDelayMs = std::min(m_probeDelayMs * 2, PROBE_MAX_MS);
+}
+
+void ConnectionStateMachine::OnWakeup(ConnectionStatus state, Clock::time_point now)
+{
+    m_stats[Index(m_state)].wakeups++;
+    if (state == m_state)
+        return;
+
+    StateStats &previous = m_stats[Index(m_state)];
+    previous.seconds += std::chrono::duration<double>(now - m_stateSince).count();
+    Logger::InfoF("Conexión: %s -> %s (%.1f despertares/min en %s)", GetStateName(m_state), GetStateName(state),
+                  previous.WakeupsPerMinute(), GetStateName(m_state));
+
+    m_state = state;
+    m_stateSince = now;
+    m_stats[Index(state)].entries++;
+
+    // Al perder la conexión se vuelve a sondear enseguida y con el retraso mínimo
+    if (state == ConnectionStatus::DISCONNECTED)
+    {
+        m_probeDelayMs = PROBE_MIN_MS;
+        m_nextProbe = now;
+    }
+}
+
+ConnectionStateMachine::StateStats ConnectionStateMachine::GetStats(ConnectionStatus state) const
+{
+    StateStats stats = m_stats[Index(state)];
+    if (state == m_state)
+        stats.seconds += std::chrono::duration<double>(Clock::now() - m_stateSince).count();
+    return stats;
+}
+
+void ConnectionStateMachine::LogStats() const
+{
+    for (int i = 0; i < STATE_COUNT; ++i)
+    {
+        const ConnectionStatus state = static_cast<ConnectionStatus>(i);
+        const StateStats stats = GetStats(state);
+        Logger::InfoF("Conexión %-12s %8.1f s, %llu despertares (%.1f/min), %llu entradas", GetStateName(state),
+                      stats.seconds, (unsigned long long)stats.wakeups, stats.WakeupsPerMinute(),
+                      (unsigned long long)stats.entries);
+    }
+}
+
+const char *ConnectionStateMachine::GetStateName(ConnectionStatus state)
+{
+    switch (state)
+    {
+    case ConnectionStatus::DISCONNECTED:
+        return "sin simulador";
+    case ConnectionStatus::CONNECTED:
+        return "sin sesión";
+    case ConnectionStatus::IN_SESSION:
+        return "en sesión";
+    }
+    return "?";
+}
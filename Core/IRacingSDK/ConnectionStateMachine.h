@@ -0,0 +1,74 @@
+/*
+MIT License - iRacing Reputation System
+Máquina de estados de la conexión: espera por estado, sondeo con backoff y contadores
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "../../Utils/Common/Types.h"
+
+/**
+ * @brief Decide cuánto duerme el hilo de telemetría según el estado de la conexión
+ *
+ * - DISCONNECTED (simulador ausente): un intento de conexión corto (PROBE_WAIT_MS) y,
+ *   si falla, el siguiente con un retraso que se duplica hasta PROBE_MAX_MS.
+ * - CONNECTED (simulador abierto sin sesión): espera larga; si llegan ticks el
+ *   evento del SDK despierta antes.
+ * - IN_SESSION: el evento del SDK marca el ritmo (SESSION_WAIT_MS es sólo el timeout).
+ *
+ * Cuenta los despertares y el tiempo pasado en cada estado para saber cuánto
+ * cuesta cada uno (despertares por minuto).
+ */
+class ConnectionStateMachine
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int SESSION_WAIT_MS = 16;
+    static constexpr int NO_SESSION_WAIT_MS = 250;
+    static constexpr int PROBE_WAIT_MS = 20; // Un intento de conexión espera algo más de un tick a 60 Hz
+    static constexpr int PROBE_MIN_MS = 250;
+    static constexpr int PROBE_MAX_MS = 4000;
+    static constexpr int STATE_COUNT = 3;
+
+    struct StateStats
+    {
+        uint64_t wakeups = 0;
+        uint64_t entries = 0; // Veces que se ha entrado en el estado
+        double seconds = 0.0;
+
+        double WakeupsPerMinute() const { return seconds > 0.0 ? wakeups * 60.0 / seconds : 0.0; }
+    };
+
+    ConnectionStateMachine();
+
+    ConnectionStatus GetState() const { return m_state; }
+
+    // Sin conexión: ¿toca ya intentar conectar? Si no, timeUntilProbe = lo que falta
+    bool IsProbeDue(Clock::time_point now, Clock::duration &timeUntilProbe) const;
+    void OnProbeFailed(Clock::time_point now);
+
+    // Timeout de espera de datos en el estado actual
+    int GetWaitMs() const { return m_state == ConnectionStatus::IN_SESSION ? SESSION_WAIT_MS : NO_SESSION_WAIT_MS; }
+
+    // Un despertar del hilo que termina en state (aplica la transición si cambia)
+    void OnWakeup(ConnectionStatus state, Clock::time_point now);
+
+    // Estadísticas hasta ahora (incluye el tiempo del estado actual)
+    StateStats GetStats(ConnectionStatus state) const;
+    void LogStats() const;
+
+    static const char *GetStateName(ConnectionStatus state);
+
+private:
+    static int Index(ConnectionStatus state) { return static_cast<int>(state); }
+
+    ConnectionStatus m_state = ConnectionStatus::DISCONNECTED;
+    Clock::time_point m_stateSince;
+    Clock::time_point m_nextProbe; // Primer intento inmediato
+    int m_probeDelayMs = PROBE_MIN_MS;
+    StateStats m_stats[STATE_COUNT];
+};
@@ -5,11 +5,23 @@ Clase para manejar la conexión y datos del SDK de iRacing - Implementaciones
 
 #include "IRacingConnection.h"
 #include "IRacingVariables.h"
+#include "irsdk_platform.h"
 #include "../../Utils/IRacing/YAMLDriverParser.h"
 #include "../../Utils/IRacing/SessionInfoProvider.h"
 #include "../../Utils/Logging/Logger.h"
+#include <algorithm>
 #include <chrono>
 
+IRacingConnection::IRacingConnection()
+    : m_source(std::make_unique<LiveTelemetrySource>())
+{
+}
+
+IRacingConnection::IRacingConnection(std::unique_ptr<ITelemetrySource> source)
+    : m_source(source ? std::move(source) : std::make_unique<LiveTelemetrySource>())
+{
+}
+
 IRacingConnection::~IRacingConnection()
 {
     Shutdown();
@@ -39,99 +51,250 @@ void IRacingConnection::Shutdown()
 
     Logger::Info("Cerrando conexión con iRacing SDK");
 
+    StopCapture();
     m_initialized = false;
     m_connected = false;
     m_inSession = false;
-    m_sessionDrivers.clear();
+    m_sessionCache.Clear();
+    m_frame.Reset();
+    m_vars.Unbind();
+}
+
+void IRacingConnection::StartCapture(const std::string &path)
+{
+    StopCapture();
+    m_capturePath = path;
+}
+
+void IRacingConnection::StopCapture()
+{
+    m_capture.Close();
+    m_capturePath.clear();
+}
+
+void IRacingConnection::UpdateCapture()
+{
+    if (!m_capture.IsOpen())
+    {
+        if (m_capturePath.empty())
+            return;
+
+        // Sólo las variables registradas: son las únicas que el plan de copia mantiene al día
+        std::vector<std::string> names;
+        for (int id = 0; id < TelemetryVars::COUNT; ++id)
+            names.push_back(TelemetryVarRegistry::GetName(static_cast<TelemetryVars::Id>(id)));
+
+        if (!m_capture.Open(m_capturePath, m_source->GetVarHeaders(), m_source->GetNumVars(), names,
+                            m_source->GetTickRate(), m_source->GetSessionInfo()))
+        {
+            m_capturePath.clear();
+            return;
+        }
+        m_captureSessionVersion = m_sessionCache.GetVersion();
+    }
+
+    if (m_sessionCache.GetVersion() != m_captureSessionVersion && m_sessionCache.IsValid())
+    {
+        m_captureSessionVersion = m_sessionCache.GetVersion();
+        m_capture.WriteSessionInfo(m_source->GetSessionInfo());
+    }
+
+    m_capture.WriteTick(m_source->GetData());
 }
 
 ConnectionStatus IRacingConnection::Update()
 {
+    m_receivedNewTick = false;
     if (!m_initialized)
         return ConnectionStatus::DISCONNECTED;
 
-    // Esperar por datos del SDK usando el singleton
-    irsdkClient &client = irsdkClient::instance();
-    bool hasData = client.waitForData(16); // 16ms timeout
+    ConnectionStatus status = Poll();
+    m_stateMachine.OnWakeup(status, std::chrono::steady_clock::now());
+
+    // Las filas rotas no llegan como tick: se detectan por el contador de la fuente
+    if (const irsdk_readStats *readStats = m_source->GetReadStats())
+    {
+        if (readStats->tornReads > m_lastTornReads)
+            m_acquisition.tornReads += readStats->tornReads - m_lastTornReads;
+        m_lastTornReads = readStats->tornReads;
+    }
+    return status;
+}
+
+void IRacingConnection::RecordAcquisition()
+{
+    m_acquisition.ticks++;
+
+    // Hueco de SessionTick: > 1 si el simulador publicó ticks que no llegamos a leer
+    const int sessionTick = m_vars.Value(TelemetryVars::SessionTick, -1);
+    if (m_lastSessionTick >= 0 && sessionTick > m_lastSessionTick)
+    {
+        const int gap = sessionTick - m_lastSessionTick;
+        m_acquisition.tickGap.Record(static_cast<uint64_t>(gap));
+        m_acquisition.droppedTicks += static_cast<uint64_t>(gap - 1);
+    }
+    m_lastSessionTick = sessionTick;
+
+    if (const irsdk_readStats *readStats = m_source->GetReadStats())
+    {
+        m_acquisition.retries.Record(static_cast<uint64_t>(readStats->lastRetries));
+        m_acquisition.copyNs.Record(static_cast<uint64_t>(readStats->lastCopyNs));
+    }
+
+    const long long signalNs = m_source->GetLastSignalNs();
+    if (signalNs > 0)
+    {
+        const long long latency = irsdkPlatform_nowNs() - signalNs;
+        if (latency >= 0)
+            m_acquisition.latencyNs.Record(static_cast<uint64_t>(latency));
+    }
+}
+
+void IRacingConnection::Wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeRequested = true;
+    }
+    m_wakeCv.notify_all();
+}
+
+bool IRacingConnection::SleepFor(std::chrono::steady_clock::duration duration)
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    bool woken = m_wakeCv.wait_for(lock, duration, [this]()
+                                   { return m_wakeRequested; });
+    m_wakeRequested = false;
+    return woken;
+}
+
+ConnectionStatus IRacingConnection::Poll()
+{
+    bool hasData;
+    if (m_stateMachine.GetState() == ConnectionStatus::DISCONNECTED)
+    {
+        // Simulador ausente: entre intentos se duerme (Wake() interrumpe) y cada intento
+        // de conexión espera como mucho un tick
+        std::chrono::steady_clock::duration untilProbe;
+        if (!m_stateMachine.IsProbeDue(std::chrono::steady_clock::now(), untilProbe) && SleepFor(untilProbe))
+            return ConnectionStatus::DISCONNECTED;
+
+        hasData = m_source->WaitForData(ConnectionStateMachine::PROBE_WAIT_MS);
+        if (!m_source->IsConnected())
+            m_stateMachine.OnProbeFailed(std::chrono::steady_clock::now());
+        else if (!hasData)
+            hasData = m_source->WaitForData(m_stateMachine.GetWaitMs()); // Simulador presente: su primer tick llega con el evento
+    }
+    else
+    {
+        // Conectado: espera de datos de la fuente (simulador o .ibt) con el timeout del estado
+        hasData = m_source->WaitForData(m_stateMachine.GetWaitMs());
+    }
+    m_receivedNewTick = hasData && m_source->IsConnected();
 
-    if (!hasData || !client.isConnected())
+    if (!m_source->IsConnected())
     {
         if (m_connected)
         {
             Logger::Info("Conexión con iRacing perdida");
             m_connected = false;
             m_inSession = false;
-            m_sessionDrivers.clear();
+            m_sessionCache.Clear();
+            m_frame.Reset();
+            m_vars.Unbind();
         }
         return ConnectionStatus::DISCONNECTED;
     }
 
-    // Verificar si hay cambios
-    int currentStatusID = client.getStatusID();
-    if (currentStatusID == m_lastStatusID)
+    // Sin tick nuevo dentro del timeout: mantener el estado actual
+    if (!hasData)
     {
         return m_connected ? (m_inSession ? ConnectionStatus::IN_SESSION : ConnectionStatus::CONNECTED)
                            : ConnectionStatus::DISCONNECTED;
     }
 
-    m_lastStatusID = currentStatusID;
-
-    // Marcar como conectado si no lo estaba
-    if (!m_connected)
+    // Un statusID nuevo indica una conexión nueva: el contador de sesión vuelve a empezar
+    int currentStatusID = m_source->GetStatusID();
+    if (currentStatusID != m_lastStatusID)
     {
-        Logger::Info("Conectado a iRacing");
-        m_connected = true;
+        if (m_capture.IsOpen())
+        {
+            Logger::Info("Captura detenida: la fuente se ha reconectado");
+            StopCapture();
+        }
+
+        m_lastStatusID = currentStatusID;
+        m_lastSessionTick = -1;
+        m_closingRate.Reset();
+        m_acquisition.tickRate = m_source->GetTickRate();
+        m_sessionCache.Clear();
+        m_frame.Reset();
+
+        // Resolver una sola vez los offsets de las variables que usamos en esta conexión
+        m_vars.Bind(m_source->GetVarHeaders(), m_source->GetNumVars());
+
+        // Y copiar de la memoria compartida sólo esas variables en los siguientes ticks
+        irsdk_copyRange ranges[TelemetryVars::COUNT];
+        int rangeCount = m_vars.BuildCopyRanges(ranges, TelemetryVars::COUNT);
+        m_source->SetCopyRanges(ranges, rangeCount);
+        Logger::InfoF("Plan de copia: %d variables, %d de %d bytes por tick", rangeCount,
+                      m_source->GetCopyBytes(), m_source->GetBufLen());
+
+        // Marcar como conectado si no lo estaba
+        if (!m_connected)
+        {
+            Logger::Info("Conectado a iRacing");
+            m_connected = true;
+        }
     }
 
-    // Actualizar información de sesión
+    m_vars.SetData(m_source->GetData());
+
+    // Actualizar información de sesión (el YAML sólo se reparsea si cambió sessionInfoUpdate)
     ParseSessionInfo();
+    UpdateCapture();
+    RecordAcquisition();
 
     return m_inSession ? ConnectionStatus::IN_SESSION : ConnectionStatus::CONNECTED;
 }
 
 void IRacingConnection::UpdateDriverData()
 {
-    Logger::Info("Actualizando datos de pilotos (aceptando position=0) ...");
-
     try
     {
         // Solo procesamos si tenemos un playerCarIdx válido
         if (m_carIdx >= 0)
         {
-            // Obtener datos del jugador desde las variables globales
             m_playerData.carIdx = m_carIdx;
             m_playerData.isPlayer = true;
-
-            try
-            {
-                m_playerData.position = ir_CarIdxPosition.getInt(m_carIdx);
-            }
-            catch (...)
-            {
-                m_playerData.position = 0; // Default cuando no hay datos
-            }
-
-            Logger::Info("✓ Datos del jugador actualizados - Posición: " + std::to_string(m_playerData.position));
         }
 
-        int driverCount = 0;
-        for (int i = 0; i < 64; ++i)
-        {
-            try
-            {
-                int position = ir_CarIdxPosition.getInt(i);
-                if (position >= 0)
-                { // Aceptar position=0 también
-                    driverCount++;
-                }
-            }
-            catch (...)
-            {
-                // Skip invalid entries
-            }
-        }
-
-        Logger::Info("✓ Capturados " + std::to_string(driverCount) + " pilotos (posiciones pueden ser 0)");
+        // El roster cacheado no se toca en cada tick: la telemetría por coche va al frame SoA.
+        // Las vistas apuntan directamente a la fila del SDK, así que cada array es una copia contigua
+        auto position = m_vars.Get(TelemetryVars::CarIdxPosition);
+        auto lap = m_vars.Get(TelemetryVars::CarIdxLap);
+        auto lapDistPct = m_vars.Get(TelemetryVars::CarIdxLapDistPct);
+        auto estTime = m_vars.Get(TelemetryVars::CarIdxEstTime);
+        auto onPitRoad = m_vars.Get(TelemetryVars::CarIdxOnPitRoad);
+        auto trackSurface = m_vars.Get(TelemetryVars::CarIdxTrackSurface);
+
+        if (position.IsValid())
+            std::copy(position.begin(), position.end(), m_frame.position); // Aceptar position=0 también
+        if (lap.IsValid())
+            std::copy(lap.begin(), lap.end(), m_frame.lap);
+        if (lapDistPct.IsValid())
+            std::copy(lapDistPct.begin(), lapDistPct.end(), m_frame.lapDistPct);
+        if (estTime.IsValid())
+            std::copy(estTime.begin(), estTime.end(), m_frame.estTime);
+        if (onPitRoad.IsValid()) // Sin estas dos se queda el valor de Reset(): todos en pista
+            std::copy(onPitRoad.begin(), onPitRoad.end(), m_frame.onPitRoad);
+        if (trackSurface.IsValid())
+            std::copy(trackSurface.begin(), trackSurface.end(), m_frame.trackSurface);
+
+        if (m_carIdx >= 0 && m_carIdx < IR_MAX_CARS)
+            m_playerData.position = m_frame.position[m_carIdx];
+
+        CalculateGapsToPlayer();
     }
     catch (...)
     {
@@ -141,28 +304,12 @@ void IRacingConnection::UpdateDriverData()
 
 void IRacingConnection::CalculateGapsToPlayer()
 {
-    if (m_sessionDrivers.empty() || m_carIdx < 0)
-        return;
-
-    // Por ahora, simplificamos el cálculo de gaps
-    // En una implementación completa, usaríamos las variables irsdkCVar correspondientes
-
-    for (auto &driver : m_sessionDrivers)
-    {
-        if (driver.carIdx == m_carIdx)
-            continue;
-
-        // Cálculo simplificado basado en posición
-        int gapPositions = driver.position - m_playerData.position;
-        driver.gapToPlayer = gapPositions * 5.0f; // Estimación: 5 segundos por posición
-        driver.isAhead = gapPositions < 0;        // Posición menor = adelante
-    }
-}
-
-void IRacingConnection::ParseDriverInfoYAML(const std::string &yaml)
-{
-    // Usar el parser YAML extraído para mejor organización del código
-    m_sessionDrivers = YAMLDriverParser::ParseDriverInfoFromYAML(yaml, m_carIdx);
+    // Una pasada para los 64 coches, con la longitud real de la pista, el orden en pista
+    // que usan las búsquedas de proximidad de los consumidores y el tiempo hasta contacto
+    const float trackLength = m_sessionCache.Get().weekend.trackLengthMeters;
+    GapEngine::Compute(m_frame, m_carIdx, trackLength);
+    GapEngine::SortByTrackPosition(m_frame, m_carIdx);
+    m_closingRate.Update(m_frame, m_carIdx, m_vars.Value(TelemetryVars::SessionTime), trackLength);
 }
 
 void IRacingConnection::ParseSessionInfo()
@@ -173,12 +320,12 @@ void IRacingConnection::ParseSessionInfo()
     try
     {
         // Verificar estado básico de conexión
-        bool isOnTrack = ir_IsOnTrack.getBool();
-        bool isOnTrackCar = ir_IsOnTrackCar.getBool();
-        int playerCarIdx = ir_PlayerCarIdx.getInt();
-        int sessionState = ir_SessionState.getInt();
+        bool isOnTrack = m_vars.Value(TelemetryVars::IsOnTrack);
+        bool isOnTrackCar = m_vars.Value(TelemetryVars::IsOnTrackCar);
+        int playerCarIdx = m_vars.Value(TelemetryVars::PlayerCarIdx, -1);
+        int sessionState = m_vars.Value(TelemetryVars::SessionState);
 
-        Logger::Info("Estado SDK - IsOnTrack: " + std::string(isOnTrack ? "SI" : "NO") +
+        Logger::Debug("Estado SDK - IsOnTrack: " + std::string(isOnTrack ? "SI" : "NO") +
                      " | IsOnTrackCar: " + std::string(isOnTrackCar ? "SI" : "NO") +
                      " | PlayerCarIdx: " + std::to_string(playerCarIdx) +
                      " | SessionState: " + std::to_string(sessionState));
@@ -193,6 +340,7 @@ void IRacingConnection::ParseSessionInfo()
 
         if (inValidSession)
         {
+            bool wasInSession = m_inSession;
             m_inSession = true;
 
             // Log del estado de la sesión
@@ -222,28 +370,37 @@ void IRacingConnection::ParseSessionInfo()
                 break;
             }
 
-            Logger::Info("✓ SESIÓN ACTIVA DETECTADA - Estado: " + stateText + " | PlayerCarIdx: " + std::to_string(m_carIdx));
+            if (!wasInSession)
+                Logger::Info("✓ SESIÓN ACTIVA DETECTADA - Estado: " + stateText + " | PlayerCarIdx: " + std::to_string(m_carIdx));
+
+            // Parsear YAML para nombres reales, sólo si el SDK ha publicado uno nuevo
+            int sessionCt = m_source->GetSessionInfoUpdate();
+            if (sessionCt != m_sessionCache.GetUpdateCount())
+                m_sessionCache.Refresh(sessionCt, m_source->GetSessionInfo(), m_carIdx);
+
             UpdateDriverData();
-            // Parsear YAML para nombres reales
-            irsdkClient &client = irsdkClient::instance();
-            ParseDriverInfoYAML(client.getSessionStr());
         }
         else
         {
-            Logger::Info("⚠ No en sesión activa - usando datos mock (CarIdx=" + std::to_string(playerCarIdx) +
-                         ", SessionState=" + std::to_string(sessionState) + ")");
-            m_sessionDrivers.clear();
+            if (m_inSession || m_sessionCache.IsValid())
+                Logger::Info("⚠ No en sesión activa - usando datos mock (CarIdx=" + std::to_string(playerCarIdx) +
+                             ", SessionState=" + std::to_string(sessionState) + ")");
+            m_inSession = false;
+            m_sessionCache.Clear();
+            m_frame.Reset();
         }
     }
     catch (...)
     {
         m_inSession = false;
-        m_sessionDrivers.clear();
+        m_sessionCache.Clear();
+        m_frame.Reset();
         Logger::Warning("Error accediendo a variables SDK - fallback a mock data");
     }
 
-    // Determinar tipo de sesión (por ahora, simplificado)
-    m_currentSessionType = SessionType::PRACTICE; // Default
+    // Determinar tipo de sesión a partir de la lista de sesiones cacheada
+    const SessionDesc *session = m_sessionCache.Get().FindSession(m_vars.Value(TelemetryVars::SessionNum));
+    m_currentSessionType = session ? session->type : SessionType::PRACTICE; // Default
 }
 
 SessionType IRacingConnection::DetermineSessionType(const std::string &sessionInfo)
@@ -251,30 +408,9 @@ SessionType IRacingConnection::DetermineSessionType(const std::string &sessionIn
     return SessionInfoProvider::DetermineSessionType(sessionInfo);
 }
 
-DriverData IRacingConnection::GetDriverByCarIdx(int carIdx) const
-{
-    for (const auto &driver : m_sessionDrivers)
-    {
-        if (driver.carIdx == carIdx)
-            return driver;
-    }
-    return DriverData{}; // Datos vacíos si no se encuentra
-}
-
-DriverData IRacingConnection::GetDriverByCustomerId(int customerId) const
-{
-    for (const auto &driver : m_sessionDrivers)
-    {
-        if (driver.customerId == customerId)
-            return driver;
-    }
-    return DriverData{}; // Datos vacíos si no se encuentra
-}
-
 bool IRacingConnection::HasNewData() const
 {
-    irsdkClient &client = irsdkClient::instance();
-    return client.isConnected();
+    return m_source->IsConnected();
 }
 
 void IRacingConnection::LogSessionInfo() const
@@ -287,14 +423,14 @@ void IRacingConnection::LogSessionInfo() const
                                                                                                                             : "Unknown");
 
     Logger::InfoF("Pilotos en sesión: %d, Car Idx jugador: %d",
-                  static_cast<int>(m_sessionDrivers.size()), m_carIdx);
+                  static_cast<int>(m_sessionCache.GetDrivers().size()), m_carIdx);
 }
 
 std::string IRacingConnection::GetSessionInfoString() const
 {
     // Obtener el string de SessionInfo del SDK
-    irsdkClient &client = irsdkClient::instance();
-    return client.getSessionStr();
+    const char *sessionStr = m_source->GetSessionInfo();
+    return sessionStr ? sessionStr : "";
 }
 
 // Funciones estilo iRon para información extendida
@@ -310,11 +446,11 @@ std::string IRacingConnection::GetCurrentSessionInfo() const
 
 float IRacingConnection::GetStrengthOfField() const
 {
-    return SessionInfoProvider::GetStrengthOfField(m_sessionDrivers);
+    return SessionInfoProvider::GetStrengthOfField(m_sessionCache.GetDrivers());
 }
 
-std::vector<DriverData> IRacingConnection::GetExtendedDriverInfo() const
+const std::vector<DriverData> &IRacingConnection::GetExtendedDriverInfo() const
 {
     // Return current drivers with all the extended info we now parse
-    return m_sessionDrivers;
+    return m_sessionCache.GetDrivers();
 }
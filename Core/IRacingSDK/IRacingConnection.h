@@ -3,11 +3,23 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 
 #include "irsdk_defines.h"
 #include "irsdk_client.h"
 #include "yaml_parser.h"
 #include "IRacingVariables.h"
+#include "SessionInfoCache.h"
+#include "ITelemetrySource.h"
+#include "LiveTelemetrySource.h"
+#include "TelemetryVarRegistry.h"
+#include "ConnectionStateMachine.h"
+#include "AcquisitionStats.h"
+#include "../ProximityDetector/GapEngine.h"
+#include "../ProximityDetector/ClosingRateEstimator.h"
+#include "../Capture/CaptureWriter.h"
 #include "../../Utils/Common/Types.h"
 #include "../../Utils/Logging/Logger.h"
 #include "../../Utils/IRacing/StringUtils.h"
@@ -25,29 +37,52 @@
 class IRacingConnection
 {
 public:
-    // Constructor y destructor
-    IRacingConnection() = default;
+    // Constructor y destructor. Sin fuente explícita se lee el simulador en vivo
+    IRacingConnection();
+    explicit IRacingConnection(std::unique_ptr<ITelemetrySource> source);
     ~IRacingConnection();
 
     // Gestión de conexión
     bool Initialize();
     void Shutdown();
-    ConnectionStatus Update();
+    ConnectionStatus Update(); // Bloquea hasta un tick, el timeout del estado o el siguiente sondeo
+    void Wake();               // Interrumpe la espera entre sondeos (thread-safe)
 
     // Estado de conexión
     bool IsConnected() const { return m_connected; }
     bool IsInSession() const { return m_inSession; }
     bool IsInitialized() const { return m_initialized; }
+    bool ReceivedNewTick() const { return m_receivedNewTick; } // El último Update() trajo un tick nuevo
+    const ConnectionStateMachine &GetStateMachine() const { return m_stateMachine; }
+    const AcquisitionStats &GetAcquisitionStats() const { return m_acquisition; }
+    void ResetAcquisitionStats()
+    {
+        const int tickRate = m_acquisition.tickRate;
+        m_acquisition.Reset();
+        m_acquisition.tickRate = tickRate;
+    }
 
     // Datos de sesión
-    const std::vector<DriverData> &GetSessionDrivers() const { return m_sessionDrivers; }
+    const std::vector<DriverData> &GetSessionDrivers() const { return m_sessionCache.GetDrivers(); }
+    const SessionInfoData &GetSessionInfo() const { return m_sessionCache.Get(); }
+    uint64_t GetSessionInfoVersion() const { return m_sessionCache.GetVersion(); }
+    const RosterSnapshotPtr &GetRoster() const { return m_sessionCache.GetRoster(); } // Compartible entre hilos
+    const CarTelemetryFrame &GetTelemetryFrame() const { return m_frame; }
+    const TelemetryVarRegistry &GetVars() const { return m_vars; } // Vistas tipadas sobre la fila del último tick
     int GetPlayerCarIdx() const { return m_carIdx; }
     const DriverData &GetPlayerData() const { return m_playerData; }
     SessionType GetCurrentSessionType() const { return m_currentSessionType; }
 
-    // Búsqueda de pilotos
-    DriverData GetDriverByCarIdx(int carIdx) const;
-    DriverData GetDriverByCustomerId(int customerId) const;
+    // Grabación de las variables registradas en formato .ircap desde el siguiente tick.
+    // Se detiene sola si la fuente se reconecta (las cabeceras pueden cambiar)
+    void StartCapture(const std::string &path);
+    void StopCapture();
+    bool IsCapturing() const { return m_capture.IsOpen(); }
+
+    // Búsqueda de pilotos: O(1) sobre el roster actual; nullptr si no está. Válido hasta el siguiente YAML
+    // (quien lo necesite más tiempo debe quedarse con GetRoster())
+    const DriverData *GetDriverByCarIdx(int carIdx) const { return m_sessionCache.GetRoster()->FindByCarIdx(carIdx); }
+    const DriverData *GetDriverByCustomerId(int customerId) const { return m_sessionCache.GetRoster()->FindByCustomerId(customerId); }
 
     // Métodos de información
     bool HasNewData() const;
@@ -58,28 +93,51 @@ public:
     std::string GetSessionType() const;
     std::string GetCurrentSessionInfo() const;
     float GetStrengthOfField() const;
-    std::vector<DriverData> GetExtendedDriverInfo() const;
+    const std::vector<DriverData> &GetExtendedDriverInfo() const;
 
 private:
+    std::unique_ptr<ITelemetrySource> m_source;
+
     // Estado de conexión
     bool m_initialized = false;
     bool m_connected = false;
     bool m_inSession = false;
+    bool m_receivedNewTick = false;
 
     // Control de actualizaciones
+    ConnectionStateMachine m_stateMachine;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    bool m_wakeRequested = false;
     int m_lastStatusID = -1;
+
+    // Instrumentación de la adquisición
+    AcquisitionStats m_acquisition;
+    int m_lastSessionTick = -1;
+    int m_lastTornReads = 0;
     std::chrono::steady_clock::time_point m_lastUpdateTime;
 
-    // Datos de sesión
-    std::vector<DriverData> m_sessionDrivers;
+    // Datos de sesión (sólo se reparsean cuando cambia sessionInfoUpdate)
+    SessionInfoCache m_sessionCache;
     DriverData m_playerData;
+    CarTelemetryFrame m_frame; // Telemetría por coche del último tick
+    ClosingRateEstimator m_closingRate; // Ventana de posiciones para closingSpeed / timeToContact
+    TelemetryVarRegistry m_vars; // Offsets resueltos al cambiar statusID
     int m_carIdx = -1;
     SessionType m_currentSessionType = SessionType::UNKNOWN;
 
+    // Captura: se abre en el primer tick tras StartCapture(), con las cabeceras ya resueltas
+    CaptureWriter m_capture;
+    std::string m_capturePath;
+    uint64_t m_captureSessionVersion = 0;
+
     // Métodos privados
+    ConnectionStatus Poll();
+    bool SleepFor(std::chrono::steady_clock::duration duration); // true = interrumpida por Wake()
+    void UpdateCapture();
+    void RecordAcquisition();
     void ParseSessionInfo();
     void UpdateDriverData();
     void CalculateGapsToPlayer();
-    void ParseDriverInfoYAML(const std::string &yaml);
     SessionType DetermineSessionType(const std::string &sessionInfo);
 };
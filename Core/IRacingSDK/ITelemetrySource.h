@@ -0,0 +1,44 @@
+/*
+MIT License - iRacing Reputation System
+Interfaz de fuente de telemetría (simulador en vivo o archivo .ibt)
+*/
+
+#pragma once
+
+#include "irsdk_defines.h"
+
+// Lo que IRacingConnection necesita de una fuente: esperar filas nuevas, la tabla de
+// cabeceras de variables, la fila actual y el YAML de sesión. Sólo se usa desde el
+// hilo lector.
+class ITelemetrySource
+{
+public:
+    virtual ~ITelemetrySource() = default;
+
+    // Bloquea hasta que hay una fila nueva o vence el timeout. true = hay fila nueva
+    virtual bool WaitForData(int timeoutMS) = 0;
+    virtual bool IsConnected() const = 0;
+
+    // Cambia con cada conexión nueva (o archivo abierto): las cabeceras pueden haber cambiado
+    virtual int GetStatusID() const = 0;
+
+    virtual const irsdk_varHeader *GetVarHeaders() const = 0;
+    virtual int GetNumVars() const = 0;
+    virtual int GetBufLen() const = 0;
+    virtual int GetTickRate() const = 0;
+
+    // Fila actual, con el layout de GetVarHeaders()
+    virtual const char *GetData() const = 0;
+
+    // Contador que cambia cuando cambia el YAML, y el YAML en sí
+    virtual int GetSessionInfoUpdate() const = 0;
+    virtual const char *GetSessionInfo() const = 0;
+
+    // Limitar la copia de cada fila a estos rangos (sólo tiene efecto si la fuente copia filas)
+    virtual void SetCopyRanges(const irsdk_copyRange * /*ranges*/, int /*count*/) {}
+    virtual int GetCopyBytes() const { return GetBufLen(); }
+
+    // Instrumentación de la lectura (sólo las fuentes que copian filas de memoria compartida)
+    virtual const irsdk_readStats *GetReadStats() const { return nullptr; }
+    virtual long long GetLastSignalNs() const { return 0; } // irsdkPlatform_nowNs() de la señal del productor
+};
@@ -0,0 +1,163 @@
+/*
+MIT License - iRacing Reputation System
+Lector de archivos .ibt mapeados en memoria - Implementaciones
+*/
+
+#include "IbtMappedFile.h"
+#include "irsdk_platform.h"
+#include "../../Utils/Logging/Logger.h"
+#include <cstring>
+
+IbtMappedFile::~IbtMappedFile()
+{
+    Close();
+}
+
+bool IbtMappedFile::Open(const std::string &path)
+{
+    Close();
+
+    size_t size = 0;
+    const char *base = irsdkPlatform_mapFile(path.c_str(), &size);
+    if (!base)
+    {
+        Logger::Error("No se pudo mapear el archivo de telemetría: " + path);
+        return false;
+    }
+
+    // Validar que las tablas que vamos a exponer como punteros caben en el archivo
+    const irsdk_header *header = reinterpret_cast<const irsdk_header *>(base);
+    const size_t headersEnd = sizeof(irsdk_header) + sizeof(irsdk_diskSubHeader);
+    const bool valid = size >= headersEnd && header->numVars > 0 && header->bufLen > 0 &&
+                       header->varHeaderOffset >= 0 &&
+                       static_cast<size_t>(header->varHeaderOffset) + header->numVars * sizeof(irsdk_varHeader) <= size &&
+                       header->sessionInfoOffset >= 0 && header->sessionInfoLen >= 0 &&
+                       static_cast<size_t>(header->sessionInfoOffset) + header->sessionInfoLen <= size &&
+                       header->varBuf[0].bufOffset >= 0 && static_cast<size_t>(header->varBuf[0].bufOffset) <= size;
+    if (!valid)
+    {
+        Logger::Error("Archivo .ibt no válido: " + path);
+        irsdkPlatform_unmapFile(base, size);
+        return false;
+    }
+
+    // Cada variable tiene que caer dentro de un registro: los lectores usan offset y count tal cual
+    const irsdk_varHeader *vars = reinterpret_cast<const irsdk_varHeader *>(base + header->varHeaderOffset);
+    for (int i = 0; i < header->numVars; ++i)
+    {
+        const irsdk_varHeader &var = vars[i];
+        if (var.offset < 0 || var.count <= 0 || var.type < 0 || var.type >= irsdk_ETCount ||
+            static_cast<long long>(var.offset) + static_cast<long long>(irsdk_VarTypeBytes[var.type]) * var.count > header->bufLen)
+        {
+            Logger::ErrorF("Archivo .ibt no válido: %s (cabecera de variable %d fuera del registro)", path.c_str(), i);
+            irsdkPlatform_unmapFile(base, size);
+            return false;
+        }
+    }
+
+    m_base = base;
+    m_size = size;
+    m_recordCount = static_cast<int>((size - header->varBuf[0].bufOffset) / header->bufLen);
+
+    // El YAML del archivo no siempre termina en '\0'
+    const char *yaml = base + header->sessionInfoOffset;
+    m_sessionInfo.assign(yaml, strnlen(yaml, header->sessionInfoLen));
+
+    int timeIdx = FindVar("SessionTime");
+    if (timeIdx >= 0 && GetVarHeaders()[timeIdx].type == irsdk_double)
+        m_sessionTimeOffset = GetVarHeaders()[timeIdx].offset;
+
+    Logger::InfoF("Archivo .ibt mapeado: %s (%d registros de %d bytes)", path.c_str(), m_recordCount, header->bufLen);
+    return true;
+}
+
+void IbtMappedFile::Close()
+{
+    if (m_base)
+        irsdkPlatform_unmapFile(m_base, m_size);
+
+    m_base = nullptr;
+    m_size = 0;
+    m_recordCount = 0;
+    m_sessionTimeOffset = -1;
+    m_sessionInfo.clear();
+}
+
+const irsdk_header *IbtMappedFile::GetHeader() const
+{
+    return reinterpret_cast<const irsdk_header *>(m_base);
+}
+
+const irsdk_diskSubHeader *IbtMappedFile::GetSubHeader() const
+{
+    return m_base ? reinterpret_cast<const irsdk_diskSubHeader *>(m_base + sizeof(irsdk_header)) : nullptr;
+}
+
+const irsdk_varHeader *IbtMappedFile::GetVarHeaders() const
+{
+    return m_base ? reinterpret_cast<const irsdk_varHeader *>(m_base + GetHeader()->varHeaderOffset) : nullptr;
+}
+
+int IbtMappedFile::GetNumVars() const
+{
+    return m_base ? GetHeader()->numVars : 0;
+}
+
+int IbtMappedFile::GetBufLen() const
+{
+    return m_base ? GetHeader()->bufLen : 0;
+}
+
+int IbtMappedFile::GetTickRate() const
+{
+    return m_base ? GetHeader()->tickRate : 0;
+}
+
+int IbtMappedFile::FindVar(const char *name) const
+{
+    const irsdk_varHeader *vars = GetVarHeaders();
+    for (int i = 0; i < GetNumVars(); ++i)
+    {
+        if (strncmp(vars[i].name, name, IRSDK_MAX_STRING) == 0)
+            return i;
+    }
+    return -1;
+}
+
+const char *IbtMappedFile::GetRecord(int index) const
+{
+    if (index < 0 || index >= m_recordCount)
+        return nullptr;
+    return m_base + GetHeader()->varBuf[0].bufOffset + static_cast<size_t>(index) * GetHeader()->bufLen;
+}
+
+double IbtMappedFile::GetRecordTime(int index) const
+{
+    const char *record = GetRecord(index);
+    if (!record || m_sessionTimeOffset < 0)
+        return -1.0;
+
+    // Los registros no están alineados a 8 bytes en general
+    double time;
+    memcpy(&time, record + m_sessionTimeOffset, sizeof(time));
+    return time;
+}
+
+int IbtMappedFile::FindRecordByTime(double sessionTime) const
+{
+    if (m_sessionTimeOffset < 0)
+        return -1;
+
+    // SessionTime crece de forma monótona dentro de un archivo
+    int lo = 0;
+    int hi = m_recordCount;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (GetRecordTime(mid) < sessionTime)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
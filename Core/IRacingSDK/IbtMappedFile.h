@@ -0,0 +1,64 @@
+/*
+MIT License - iRacing Reputation System
+Lector de archivos .ibt mapeados en memoria (acceso aleatorio por registro y por tiempo)
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "irsdk_defines.h"
+
+/**
+ * @brief Un .ibt completo mapeado en memoria de sólo lectura
+ *
+ * A diferencia de irsdkDiskClient, que hace un fread de bufLen por registro y sólo
+ * avanza, aquí cada registro es un puntero dentro del mapeo: GetRecord(i) es O(1) y
+ * FindRecordByTime() hace búsqueda binaria sobre SessionTime. Los punteros son
+ * válidos hasta Close().
+ */
+class IbtMappedFile
+{
+public:
+    IbtMappedFile() = default;
+    ~IbtMappedFile();
+
+    IbtMappedFile(const IbtMappedFile &) = delete;
+    IbtMappedFile &operator=(const IbtMappedFile &) = delete;
+
+    bool Open(const std::string &path);
+    void Close();
+    bool IsOpen() const { return m_base != nullptr; }
+
+    const irsdk_header *GetHeader() const;
+    const irsdk_diskSubHeader *GetSubHeader() const;
+    const irsdk_varHeader *GetVarHeaders() const;
+    int GetNumVars() const;
+    int GetBufLen() const;
+    int GetTickRate() const;
+    const char *GetSessionInfo() const { return m_sessionInfo.c_str(); }
+
+    // Archivo completo tal cual está mapeado
+    const char *GetBytes() const { return m_base; }
+    size_t GetSize() const { return m_size; }
+
+    // Índice en GetVarHeaders(), -1 si el archivo no la tiene
+    int FindVar(const char *name) const;
+
+    // Registros completos presentes en el archivo (un .ibt cortado pierde sólo el último)
+    int GetRecordCount() const { return m_recordCount; }
+    const char *GetRecord(int index) const;
+
+    // Primer registro con SessionTime >= sessionTime (GetRecordCount() si no hay ninguno,
+    // -1 si el archivo no tiene SessionTime)
+    int FindRecordByTime(double sessionTime) const;
+    double GetRecordTime(int index) const;
+
+private:
+    const char *m_base = nullptr;
+    size_t m_size = 0;
+    int m_recordCount = 0;
+    int m_sessionTimeOffset = -1;
+    std::string m_sessionInfo;
+};
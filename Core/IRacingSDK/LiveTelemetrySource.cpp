@@ -0,0 +1,81 @@
+/*
+MIT License - iRacing Reputation System
+Fuente de telemetría en vivo - Implementaciones
+*/
+
+#include "LiveTelemetrySource.h"
+#include "irsdk_client.h"
+#include "irsdk_platform.h"
+
+bool LiveTelemetrySource::WaitForData(int timeoutMS)
+{
+    return irsdkClient::instance().waitForData(timeoutMS);
+}
+
+bool LiveTelemetrySource::IsConnected() const
+{
+    return irsdkClient::instance().isConnected();
+}
+
+int LiveTelemetrySource::GetStatusID() const
+{
+    return irsdkClient::instance().getStatusID();
+}
+
+const irsdk_varHeader *LiveTelemetrySource::GetVarHeaders() const
+{
+    return irsdk_getVarHeaderPtr();
+}
+
+int LiveTelemetrySource::GetNumVars() const
+{
+    const irsdk_header *header = irsdk_getHeader();
+    return header ? header->numVars : 0;
+}
+
+int LiveTelemetrySource::GetBufLen() const
+{
+    const irsdk_header *header = irsdk_getHeader();
+    return header ? header->bufLen : 0;
+}
+
+int LiveTelemetrySource::GetTickRate() const
+{
+    const irsdk_header *header = irsdk_getHeader();
+    return header ? header->tickRate : 0;
+}
+
+const char *LiveTelemetrySource::GetData() const
+{
+    return irsdkClient::instance().getData();
+}
+
+int LiveTelemetrySource::GetSessionInfoUpdate() const
+{
+    return irsdkClient::instance().getSessionCt();
+}
+
+const char *LiveTelemetrySource::GetSessionInfo() const
+{
+    return irsdkClient::instance().getSessionStr();
+}
+
+void LiveTelemetrySource::SetCopyRanges(const irsdk_copyRange *ranges, int count)
+{
+    irsdk_setCopyRanges(ranges, count);
+}
+
+int LiveTelemetrySource::GetCopyBytes() const
+{
+    return irsdk_getCopyBytes();
+}
+
+const irsdk_readStats *LiveTelemetrySource::GetReadStats() const
+{
+    return irsdk_getReadStats();
+}
+
+long long LiveTelemetrySource::GetLastSignalNs() const
+{
+    return irsdkPlatform_lastSignalNs();
+}
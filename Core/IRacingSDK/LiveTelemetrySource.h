@@ -0,0 +1,31 @@
+/*
+MIT License - iRacing Reputation System
+Fuente de telemetría en vivo (memoria compartida del simulador vía irsdkClient)
+*/
+
+#pragma once
+
+#include "ITelemetrySource.h"
+
+class LiveTelemetrySource : public ITelemetrySource
+{
+public:
+    bool WaitForData(int timeoutMS) override;
+    bool IsConnected() const override;
+    int GetStatusID() const override;
+
+    const irsdk_varHeader *GetVarHeaders() const override;
+    int GetNumVars() const override;
+    int GetBufLen() const override;
+    int GetTickRate() const override;
+    const char *GetData() const override;
+
+    int GetSessionInfoUpdate() const override;
+    const char *GetSessionInfo() const override;
+
+    void SetCopyRanges(const irsdk_copyRange *ranges, int count) override;
+    int GetCopyBytes() const override;
+
+    const irsdk_readStats *GetReadStats() const override;
+    long long GetLastSignalNs() const override;
+};
@@ -0,0 +1,137 @@
+/*
+MIT License - iRacing Reputation System
+Fuente de telemetría desde un archivo .ibt - Implementaciones
+*/
+
+#include "ReplayTelemetrySource.h"
+#include "../../Utils/Logging/Logger.h"
+#include <thread>
+
+ReplayTelemetrySource::ReplayTelemetrySource(const std::string &path, double speed, bool loop)
+    : m_path(path), m_speed(speed), m_loop(loop)
+{
+}
+
+bool ReplayTelemetrySource::Open()
+{
+    if (!m_file.Open(m_path))
+        return false;
+
+    // Para el consumidor es una conexión nueva: cabeceras y YAML se vuelven a leer
+    m_statusID++;
+    m_row = -1;
+    m_finished = false;
+    ResetClock();
+
+    Logger::InfoF("Reproduciendo %s: %d registros a %d Hz, velocidad %s", m_path.c_str(), m_file.GetRecordCount(),
+                  GetTickRate(), m_speed > 0.0 ? std::to_string(m_speed).c_str() : "máxima");
+    return true;
+}
+
+bool ReplayTelemetrySource::Seek(int row)
+{
+    if (!m_file.IsOpen() || row < 0 || row > m_file.GetRecordCount())
+        return false;
+
+    m_row = row - 1;
+    m_finished = false;
+    ResetClock();
+    return true;
+}
+
+bool ReplayTelemetrySource::SeekToTime(double sessionTime)
+{
+    return Seek(m_file.FindRecordByTime(sessionTime));
+}
+
+// El ritmo se mide desde la fila actual: tras un Seek no hay que esperar a las anteriores
+void ReplayTelemetrySource::ResetClock()
+{
+    m_start = Clock::now();
+    if (m_speed > 0.0 && GetTickRate() > 0)
+        m_start -= std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((m_row + 1) / (GetTickRate() * m_speed)));
+}
+
+bool ReplayTelemetrySource::WaitForData(int timeoutMS)
+{
+    const auto timeout = std::chrono::milliseconds(timeoutMS);
+
+    if (!m_file.IsOpen() || m_finished)
+    {
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+
+    // Cada fila se entrega en su instante relativo al inicio de la reproducción
+    if (m_speed > 0.0 && GetTickRate() > 0)
+    {
+        const double rowSeconds = (m_row + 1) / (GetTickRate() * m_speed);
+        const auto due = m_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(rowSeconds));
+        const auto now = Clock::now();
+        if (due - now > timeout)
+        {
+            std::this_thread::sleep_for(timeout);
+            return false;
+        }
+        std::this_thread::sleep_until(due);
+    }
+
+    if (m_row + 1 >= m_file.GetRecordCount())
+    {
+        if (m_loop && Seek(0))
+        {
+            // Para el consumidor es una sesión nueva
+            m_statusID++;
+            m_row = 0;
+            return true;
+        }
+
+        Logger::Info("Fin de la reproducción de " + m_path);
+        m_finished = true;
+        return false;
+    }
+
+    m_row++;
+    return true;
+}
+
+bool ReplayTelemetrySource::IsConnected() const
+{
+    return m_file.IsOpen() && !m_finished;
+}
+
+const irsdk_varHeader *ReplayTelemetrySource::GetVarHeaders() const
+{
+    return m_file.GetVarHeaders();
+}
+
+int ReplayTelemetrySource::GetNumVars() const
+{
+    return m_file.GetNumVars();
+}
+
+int ReplayTelemetrySource::GetBufLen() const
+{
+    return m_file.GetBufLen();
+}
+
+int ReplayTelemetrySource::GetTickRate() const
+{
+    return m_file.GetTickRate();
+}
+
+const char *ReplayTelemetrySource::GetData() const
+{
+    return m_file.GetRecord(m_row);
+}
+
+int ReplayTelemetrySource::GetSessionInfoUpdate() const
+{
+    // Un .ibt lleva un único YAML de sesión
+    return m_file.IsOpen() ? 1 : -1;
+}
+
+const char *ReplayTelemetrySource::GetSessionInfo() const
+{
+    return m_file.GetSessionInfo();
+}
@@ -0,0 +1,66 @@
+/*
+MIT License - iRacing Reputation System
+Fuente de telemetría desde un archivo .ibt grabado (reproducción)
+*/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "ITelemetrySource.h"
+#include "IbtMappedFile.h"
+
+/**
+ * @brief Reproduce un .ibt fila a fila como si fuera el simulador
+ *
+ * La velocidad es relativa al tickRate del archivo: 1.0 = tiempo real, N = N veces
+ * más rápido y AS_FAST_AS_POSSIBLE entrega cada fila en cuanto se pide, para
+ * benchmarks deterministas de todo el pipeline sin el simulador. El archivo está
+ * mapeado en memoria: GetData() apunta al registro dentro del mapeo y Seek() es O(1).
+ */
+class ReplayTelemetrySource : public ITelemetrySource
+{
+public:
+    static constexpr double AS_FAST_AS_POSSIBLE = 0.0;
+
+    ReplayTelemetrySource(const std::string &path, double speed = 1.0, bool loop = false);
+
+    bool Open();
+    bool IsFinished() const { return m_finished; }
+    int GetRowIndex() const { return m_row; }
+    int GetRowCount() const { return m_file.GetRecordCount(); }
+    double GetSpeed() const { return m_speed; }
+
+    // La siguiente fila entregada será row (o la primera con SessionTime >= sessionTime)
+    bool Seek(int row);
+    bool SeekToTime(double sessionTime);
+
+    bool WaitForData(int timeoutMS) override;
+    bool IsConnected() const override;
+    int GetStatusID() const override { return m_statusID; }
+
+    const irsdk_varHeader *GetVarHeaders() const override;
+    int GetNumVars() const override;
+    int GetBufLen() const override;
+    int GetTickRate() const override;
+    const char *GetData() const override;
+
+    int GetSessionInfoUpdate() const override;
+    const char *GetSessionInfo() const override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void ResetClock();
+
+    IbtMappedFile m_file;
+    std::string m_path;
+    double m_speed;
+    bool m_loop;
+
+    int m_statusID = 0;
+    int m_row = -1;
+    bool m_finished = false;
+    Clock::time_point m_start;
+};
@@ -0,0 +1,100 @@
+/*
+MIT License - iRacing Reputation System
+Caché de la información de sesión (YAML) - Implementaciones
+*/
+
+#include "SessionInfoCache.h"
+#include "../../Utils/IRacing/YAMLDriverParser.h"
+#include "../../Utils/IRacing/SessionInfoProvider.h"
+#include "../../Utils/Logging/Logger.h"
+#include <cstdio>
+#include <cstdlib>
+
+const SessionDesc *SessionInfoData::FindSession(int sessionNum) const
+{
+    for (const auto &session : sessions)
+    {
+        if (session.sessionNum == sessionNum)
+            return &session;
+    }
+    return nullptr;
+}
+
+int SessionInfoData::GetPlayerCustomerId() const
+{
+    const DriverData *player = roster->FindByCarIdx(driverCarIdx);
+    return player ? player->customerId : 0;
+}
+
+bool SessionInfoCache::Refresh(int sessionInfoUpdate, const char *sessionStr, int playerCarIdx)
+{
+    if (!sessionStr || sessionInfoUpdate < 0)
+        return false;
+
+    if (sessionInfoUpdate == m_data.updateCount)
+        return false;
+
+    SessionInfoData data;
+    data.updateCount = sessionInfoUpdate;
+    YAMLDriverParser::ParseYamlInt(sessionStr, "DriverInfo:DriverCarIdx:", &data.driverCarIdx);
+    ParseWeekendInfo(sessionStr, data.weekend);
+    ParseSessions(sessionStr, data.sessions);
+
+    auto roster = std::make_shared<RosterSnapshot>();
+    roster->version = ++m_version;
+    roster->drivers = YAMLDriverParser::ParseDriverInfoFromYAML(sessionStr, playerCarIdx);
+    roster->BuildIndex();
+    data.roster = std::move(roster);
+
+    m_data = std::move(data);
+
+    Logger::InfoF("SessionInfo reparseado (update %d): %d pilotos, %d sesiones, pista %s (%.0f m)",
+                  m_data.updateCount, static_cast<int>(m_data.roster->drivers.size()),
+                  static_cast<int>(m_data.sessions.size()), m_data.weekend.trackDisplayName.c_str(),
+                  m_data.weekend.trackLengthMeters);
+    return true;
+}
+
+void SessionInfoCache::Clear()
+{
+    auto roster = std::make_shared<RosterSnapshot>();
+    roster->version = ++m_version;
+
+    m_data = SessionInfoData{};
+    m_data.roster = std::move(roster);
+}
+
+void SessionInfoCache::ParseWeekendInfo(const char *sessionStr, WeekendInfo &out)
+{
+    YAMLDriverParser::ParseYamlStr(sessionStr, "WeekendInfo:TrackName:", out.trackName);
+    YAMLDriverParser::ParseYamlStr(sessionStr, "WeekendInfo:TrackDisplayName:", out.trackDisplayName);
+    YAMLDriverParser::ParseYamlInt(sessionStr, "WeekendInfo:TrackID:", &out.trackId);
+    YAMLDriverParser::ParseYamlInt(sessionStr, "WeekendInfo:SeriesID:", &out.seriesId);
+    YAMLDriverParser::ParseYamlInt(sessionStr, "WeekendInfo:SubSessionID:", &out.subSessionId);
+    YAMLDriverParser::ParseYamlStr(sessionStr, "WeekendInfo:EventType:", out.eventType);
+
+    // Formato "6.93 km"
+    std::string trackLength;
+    if (YAMLDriverParser::ParseYamlStr(sessionStr, "WeekendInfo:TrackLength:", trackLength))
+        out.trackLengthMeters = static_cast<float>(atof(trackLength.c_str()) * 1000.0);
+}
+
+void SessionInfoCache::ParseSessions(const char *sessionStr, std::vector<SessionDesc> &out)
+{
+    char path[128];
+    // Las sesiones se numeran de forma consecutiva desde 0
+    for (int sessionNum = 0; sessionNum < 16; ++sessionNum)
+    {
+        SessionDesc session;
+        snprintf(path, sizeof(path), "SessionInfo:Sessions:SessionNum:{%d}SessionType:", sessionNum);
+        if (!YAMLDriverParser::ParseYamlStr(sessionStr, path, session.sessionType))
+            break;
+
+        snprintf(path, sizeof(path), "SessionInfo:Sessions:SessionNum:{%d}SessionName:", sessionNum);
+        YAMLDriverParser::ParseYamlStr(sessionStr, path, session.sessionName);
+
+        session.sessionNum = sessionNum;
+        session.type = SessionInfoProvider::DetermineSessionType(session.sessionType);
+        out.push_back(std::move(session));
+    }
+}
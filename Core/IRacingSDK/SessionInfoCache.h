@@ -0,0 +1,81 @@
+/*
+MIT License - iRacing Reputation System
+Caché de la información de sesión (YAML) indexada por sessionInfoUpdate
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../Utils/Common/Types.h"
+
+// Datos de WeekendInfo: que usamos en la aplicación
+struct WeekendInfo
+{
+    std::string trackName;
+    std::string trackDisplayName;
+    float trackLengthMeters = 0.0f; // WeekendInfo:TrackLength: viene en km
+    int trackId = 0;
+    int seriesId = 0;
+    int subSessionId = 0;
+    std::string eventType;
+};
+
+// Entrada de SessionInfo:Sessions:
+struct SessionDesc
+{
+    int sessionNum = -1;
+    std::string sessionType; // "Practice", "Lone Qualify", "Race"...
+    std::string sessionName;
+    SessionType type = SessionType::UNKNOWN;
+};
+
+// Resultado completo de parsear el string de sesión
+struct SessionInfoData
+{
+    int updateCount = -1; // irsdk_header::sessionInfoUpdate con el que se parseó
+    int driverCarIdx = -1;
+    RosterSnapshotPtr roster = std::make_shared<const RosterSnapshot>(); // Nunca nulo
+    WeekendInfo weekend;
+    std::vector<SessionDesc> sessions;
+
+    const SessionDesc *FindSession(int sessionNum) const;
+
+    // customerId del jugador (DriverCarIdx), 0 si no está en el roster
+    int GetPlayerCustomerId() const;
+};
+
+/**
+ * @brief Mantiene el último parseo del string de sesión
+ *
+ * El SDK incrementa irsdk_header::sessionInfoUpdate cada vez que publica un YAML
+ * nuevo. Sólo se vuelve a parsear cuando ese contador cambia; el resto del tiempo
+ * los consumidores leen los datos cacheados por referencia. El roster de cada versión
+ * se crea una sola vez y se comparte con quien lo pida (GetRoster()).
+ */
+class SessionInfoCache
+{
+public:
+    // Reparsea sólo si sessionInfoUpdate ha cambiado. Devuelve true si hubo reparseo
+    bool Refresh(int sessionInfoUpdate, const char *sessionStr, int playerCarIdx);
+    void Clear();
+
+    bool IsValid() const { return m_data.updateCount >= 0; }
+    int GetUpdateCount() const { return m_data.updateCount; }
+    uint64_t GetVersion() const { return m_version; } // Cambia con cada Refresh efectivo o Clear
+
+    const SessionInfoData &Get() const { return m_data; }
+    const std::vector<DriverData> &GetDrivers() const { return m_data.roster->drivers; }
+
+    // Roster compartido de la versión actual (roster->version == GetVersion())
+    const RosterSnapshotPtr &GetRoster() const { return m_data.roster; }
+
+private:
+    SessionInfoData m_data;
+    uint64_t m_version = 0;
+
+    static void ParseWeekendInfo(const char *sessionStr, WeekendInfo &out);
+    static void ParseSessions(const char *sessionStr, std::vector<SessionDesc> &out);
+};
@@ -0,0 +1,134 @@
+/*
+MIT License - iRacing Reputation System
+Hilo lector de telemetría - Implementaciones
+*/
+
+#include "TelemetryReader.h"
+#include "../../Utils/Logging/Logger.h"
+
+TelemetryReader::TelemetryReader(std::unique_ptr<ITelemetrySource> source)
+    : m_connection(std::move(source))
+{
+    auto snapshot = std::make_shared<TelemetrySnapshot>();
+    snapshot->roster = m_connection.GetRoster();
+    m_snapshot = std::move(snapshot);
+}
+
+TelemetryReader::~TelemetryReader()
+{
+    Stop();
+}
+
+bool TelemetryReader::Start()
+{
+    if (m_running)
+        return true;
+
+    if (!m_connection.Initialize())
+        return false;
+
+    m_running = true;
+    m_thread = std::thread(&TelemetryReader::ThreadMain, this);
+    Logger::Info("Hilo de telemetría iniciado");
+    return true;
+}
+
+void TelemetryReader::Stop()
+{
+    if (!m_running)
+        return;
+
+    m_running = false;
+    m_connection.Wake();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    m_connection.GetStateMachine().LogStats();
+    m_connection.GetAcquisitionStats().Log();
+    PublishAcquisitionStats(true);
+    m_connection.Shutdown();
+    Logger::Info("Hilo de telemetría detenido");
+}
+
+std::shared_ptr<const TelemetrySnapshot> TelemetryReader::GetSnapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+void TelemetryReader::GetAcquisitionStats(AcquisitionStats &out) const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    out = m_publishedStats;
+}
+
+void TelemetryReader::PublishAcquisitionStats(bool force)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - m_lastStatsPublish < std::chrono::seconds(1))
+        return;
+
+    // Copia de tamaño fijo: sin reservas en el hilo lector
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    m_publishedStats = m_connection.GetAcquisitionStats();
+    m_lastStatsPublish = now;
+}
+
+void TelemetryReader::ThreadMain()
+{
+    while (m_running)
+    {
+        // Bloquea en el evento del SDK hasta el siguiente tick (o el timeout)
+        ConnectionStatus status = m_connection.Update();
+
+        if (m_connection.ReceivedNewTick() && status != ConnectionStatus::DISCONNECTED)
+            WriteTick();
+
+        PublishIfChanged(status);
+        PublishAcquisitionStats(false);
+    }
+}
+
+void TelemetryReader::WriteTick()
+{
+    // Se escribe directamente en el slot: sin copias intermedias ni reservas
+    TelemetryTick &tick = m_ring.BeginWrite();
+    const TelemetryVarRegistry &vars = m_connection.GetVars();
+    tick.sequence = ++m_tickCount;
+    tick.sessionTick = vars.Value(TelemetryVars::SessionTick);
+    tick.sessionNum = vars.Value(TelemetryVars::SessionNum, -1);
+    tick.sessionTime = vars.Value(TelemetryVars::SessionTime);
+    tick.playerCarIdx = m_connection.GetPlayerCarIdx();
+    tick.rosterVersion = m_connection.GetSessionInfoVersion();
+    tick.frame = m_connection.GetTelemetryFrame();
+    tick.captureTime = std::chrono::steady_clock::now();
+    m_ring.EndWrite();
+}
+
+void TelemetryReader::PublishIfChanged(ConnectionStatus status)
+{
+    const bool connected = status != ConnectionStatus::DISCONNECTED;
+    const bool inSession = connected && m_connection.IsInSession();
+    const int playerCarIdx = connected ? m_connection.GetPlayerCarIdx() : -1;
+    const SessionType sessionType = connected ? m_connection.GetCurrentSessionType() : SessionType::UNKNOWN;
+    const SessionInfoData &sessionInfo = m_connection.GetSessionInfo();
+
+    // Sólo el hilo lector escribe m_snapshot: leerlo aquí sin atomic_load es seguro
+    const TelemetrySnapshot &current = *m_snapshot;
+    if (current.status == status && current.inSession == inSession && current.playerCarIdx == playerCarIdx &&
+        current.sessionType == sessionType && current.roster == sessionInfo.roster)
+        return;
+
+    auto snapshot = std::make_shared<TelemetrySnapshot>();
+    snapshot->sequence = ++m_sequence;
+    snapshot->status = status;
+    snapshot->inSession = inSession;
+    snapshot->playerCarIdx = playerCarIdx;
+    snapshot->sessionType = sessionType;
+    snapshot->captureTime = std::chrono::steady_clock::now();
+    snapshot->roster = sessionInfo.roster; // Sin copia: el mismo roster que parseó SessionInfoCache
+    snapshot->trackLengthMeters = sessionInfo.weekend.trackLengthMeters;
+    snapshot->subSessionId = sessionInfo.weekend.subSessionId;
+    snapshot->playerCustomerId = sessionInfo.GetPlayerCustomerId();
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const TelemetrySnapshot>(std::move(snapshot)));
+}
@@ -0,0 +1,109 @@
+/*
+MIT License - iRacing Reputation System
+Hilo lector de telemetría desacoplado del bucle de UI
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "IRacingConnection.h"
+#include "../../Utils/Common/FrameRing.h"
+#include "../../Utils/Common/Types.h"
+
+// Estado de la sesión publicado por el hilo de telemetría. Sólo se publica uno nuevo
+// cuando cambia algo (conexión, roster, jugador, tipo de sesión); es inmutable una vez
+// publicado y los consumidores lo comparten sin copiarlo ni bloquear al lector.
+struct TelemetrySnapshot
+{
+    uint64_t sequence = 0; // Incrementa con cada publicación
+    ConnectionStatus status = ConnectionStatus::DISCONNECTED;
+    bool inSession = false;
+    int playerCarIdx = -1;
+    SessionType sessionType = SessionType::UNKNOWN;
+    float trackLengthMeters = 0.0f;
+    int subSessionId = 0;     // WeekendInfo:SubSessionID (0 sin YAML o en sesiones offline)
+    int playerCustomerId = 0; // SessionInfoData::GetPlayerCustomerId()
+    RosterSnapshotPtr roster; // Compartido con SessionInfoCache y entre snapshots hasta que cambia el YAML (nunca nulo)
+    std::chrono::steady_clock::time_point captureTime;
+};
+
+// Datos de un tick, escritos en sitio en el anillo de frames. Sin punteros ni
+// contenedores: el slot se reutiliza y los lectores lo copian tal cual.
+struct TelemetryTick
+{
+    uint64_t sequence = 0; // Ticks leídos desde el arranque
+    int sessionTick = 0;
+    int sessionNum = -1;
+    double sessionTime = 0.0;
+    int playerCarIdx = -1;
+    uint64_t rosterVersion = 0; // RosterSnapshot::version al que se refieren los carIdx
+    CarTelemetryFrame frame;    // Telemetría por coche de este tick
+    std::chrono::steady_clock::time_point captureTime;
+};
+
+// 256 ticks = 4 s a 60 Hz, ~0.7 s a 360 Hz
+using TelemetryFrameRing = FrameRing<TelemetryTick, 256>;
+
+/**
+ * @brief Lee el SDK de iRacing en su propio hilo
+ *
+ * Espera el evento de datos del SDK al ritmo de la simulación (tickRate) y
+ * escribe cada tick en un anillo de frames preasignados: nada reserva memoria por
+ * tick. Cada consumidor se suscribe con su propio cursor y lee a su ritmo (todos los
+ * ticks en orden o sólo el último); el estado de la sesión va aparte, en un
+ * TelemetrySnapshot que sólo se publica cuando cambia. Todo el acceso al SDK
+ * (irsdkClient, irsdkCVar) ocurre en este hilo.
+ */
+class TelemetryReader
+{
+public:
+    // Sin fuente explícita se lee el simulador en vivo
+    explicit TelemetryReader(std::unique_ptr<ITelemetrySource> source = nullptr);
+    ~TelemetryReader();
+
+    bool Start();
+    void Stop();
+
+    // Grabar la telemetría en un .ircap mientras dure la conexión (llamar antes de Start())
+    void SetCapturePath(const std::string &path) { m_connection.StartCapture(path); }
+    bool IsRunning() const { return m_running; }
+
+    // Último estado de sesión publicado (nunca nulo)
+    std::shared_ptr<const TelemetrySnapshot> GetSnapshot() const;
+    RosterSnapshotPtr GetRoster() const { return GetSnapshot()->roster; }
+
+    // Copia de las estadísticas de adquisición (se refresca una vez por segundo)
+    void GetAcquisitionStats(AcquisitionStats &out) const;
+
+    // Ticks por coche; los consumidores leen con su propio cursor (Subscribe())
+    const TelemetryFrameRing &GetFrameRing() const { return m_ring; }
+
+private:
+    void ThreadMain();
+    void WriteTick();
+    void PublishAcquisitionStats(bool force);
+    void PublishIfChanged(ConnectionStatus status);
+
+    IRacingConnection m_connection; // Sólo se usa desde el hilo lector
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    TelemetryFrameRing m_ring;
+    uint64_t m_tickCount = 0;
+
+    // Los histogramas los escribe el hilo lector; los demás leen esta copia
+    mutable std::mutex m_statsMutex;
+    AcquisitionStats m_publishedStats;
+    std::chrono::steady_clock::time_point m_lastStatsPublish;
+
+    std::shared_ptr<const TelemetrySnapshot> m_snapshot; // Acceso con std::atomic_load/store
+    uint64_t m_sequence = 0;
+};
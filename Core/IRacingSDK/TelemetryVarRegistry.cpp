@@ -0,0 +1,94 @@
+/*
+MIT License - iRacing Reputation System
+Registro tipado de variables de telemetría - Implementaciones
+*/
+
+#include "TelemetryVarRegistry.h"
+#include "../../Utils/Logging/Logger.h"
+#include <cstring>
+
+namespace
+{
+    struct VarDesc
+    {
+        const char *name;
+        int type;
+        int count;
+    };
+
+    const VarDesc kVarDescs[TelemetryVars::COUNT] = {
+#define IR_TELEMETRY_VAR_DESC(name, type, count) {#name, TelemetryVars::VarType<type>::value, count},
+        IR_TELEMETRY_VARS(IR_TELEMETRY_VAR_DESC)
+#undef IR_TELEMETRY_VAR_DESC
+    };
+
+    // Los bitfields del SDK se leen como int
+    bool IsCompatibleType(int expected, int actual)
+    {
+        return expected == actual || (expected == irsdk_int && actual == irsdk_bitField);
+    }
+} // namespace
+
+int TelemetryVarRegistry::Bind(const irsdk_varHeader *varHeaders, int numVars)
+{
+    Unbind();
+    if (!varHeaders || numVars <= 0)
+        return 0;
+
+    int resolved = 0;
+    for (int id = 0; id < TelemetryVars::COUNT; ++id)
+    {
+        const VarDesc &desc = kVarDescs[id];
+        for (int i = 0; i < numVars; ++i)
+        {
+            const irsdk_varHeader &header = varHeaders[i];
+            if (strncmp(desc.name, header.name, IRSDK_MAX_STRING) != 0)
+                continue;
+
+            if (!IsCompatibleType(desc.type, header.type) || header.count < desc.count)
+            {
+                Logger::Warning(std::string("Variable de telemetría con tipo o tamaño inesperado: ") + desc.name);
+                break;
+            }
+
+            m_offsets[id] = header.offset;
+            m_sizes[id] = irsdk_VarTypeBytes[header.type] * header.count;
+            ++resolved;
+            break;
+        }
+    }
+
+    m_bound = true;
+    Logger::InfoF("Variables de telemetría resueltas: %d/%d", resolved, static_cast<int>(TelemetryVars::COUNT));
+    return resolved;
+}
+
+const char *TelemetryVarRegistry::GetName(TelemetryVars::Id id)
+{
+    return id >= 0 && id < TelemetryVars::COUNT ? kVarDescs[id].name : "";
+}
+
+int TelemetryVarRegistry::BuildCopyRanges(irsdk_copyRange *out, int maxRanges) const
+{
+    int count = 0;
+    for (int id = 0; id < TelemetryVars::COUNT && count < maxRanges; ++id)
+    {
+        if (m_offsets[id] < 0)
+            continue;
+        out[count].offset = m_offsets[id];
+        out[count].len = m_sizes[id];
+        ++count;
+    }
+    return count;
+}
+
+void TelemetryVarRegistry::Unbind()
+{
+    for (int id = 0; id < TelemetryVars::COUNT; ++id)
+    {
+        m_offsets[id] = -1;
+        m_sizes[id] = 0;
+    }
+    m_data = nullptr;
+    m_bound = false;
+}
@@ -0,0 +1,150 @@
+/*
+MIT License - iRacing Reputation System
+Registro tipado de variables de telemetría con offsets resueltos una vez por conexión
+*/
+
+#pragma once
+
+#include "irsdk_defines.h"
+
+// Vista de sólo lectura sobre N elementos contiguos del buffer de datos del SDK.
+// Equivalente a std::span<const T, N> (no disponible en C++17); sin copia ni comprobaciones.
+template <typename T, int N>
+class VarSpan
+{
+public:
+    VarSpan() = default;
+    explicit VarSpan(const T *data) : m_data(data) {}
+
+    static constexpr int size() { return N; }
+    bool IsValid() const { return m_data != nullptr; }
+
+    const T *data() const { return m_data; }
+    const T &operator[](int i) const { return m_data[i]; }
+    const T *begin() const { return m_data; }
+    const T *end() const { return m_data + N; }
+
+private:
+    const T *m_data = nullptr;
+};
+
+// Variables que usa la aplicación: nombre en el SDK, tipo C++ y nº de elementos.
+// Añadir una variable aquí la registra, la valida al conectar y genera su descriptor tipado.
+#define IR_TELEMETRY_VARS(X)        \
+    X(IsOnTrack, bool, 1)           \
+    X(IsOnTrackCar, bool, 1)        \
+    X(PlayerCarIdx, int, 1)         \
+    X(SessionNum, int, 1)           \
+    X(SessionState, int, 1)         \
+    X(SessionTick, int, 1)          \
+    X(SessionTime, double, 1)       \
+    X(CarIdxLap, int, 64)           \
+    X(CarIdxLapDistPct, float, 64)  \
+    X(CarIdxEstTime, float, 64)     \
+    X(CarIdxPosition, int, 64)      \
+    X(CarIdxClassPosition, int, 64) \
+    X(CarIdxOnPitRoad, bool, 64)    \
+    X(CarIdxTrackSurface, int, 64)
+
+namespace TelemetryVars
+{
+
+    enum Id
+    {
+#define IR_TELEMETRY_VAR_ID(name, type, count) name##_Id,
+        IR_TELEMETRY_VARS(IR_TELEMETRY_VAR_ID)
+#undef IR_TELEMETRY_VAR_ID
+            COUNT
+    };
+
+    // Descriptor de una variable: el tipo y el tamaño van en el tipo, no en tiempo de ejecución
+    template <typename T, int N>
+    struct Def
+    {
+        Id id;
+    };
+
+#define IR_TELEMETRY_VAR_DEF(name, type, count) constexpr Def<type, count> name{name##_Id};
+    IR_TELEMETRY_VARS(IR_TELEMETRY_VAR_DEF)
+#undef IR_TELEMETRY_VAR_DEF
+
+    // Tipo del SDK que corresponde a cada tipo C++
+    template <typename T>
+    struct VarType;
+    template <>
+    struct VarType<bool>
+    {
+        static constexpr int value = irsdk_bool;
+    };
+    template <>
+    struct VarType<int>
+    {
+        static constexpr int value = irsdk_int;
+    };
+    template <>
+    struct VarType<float>
+    {
+        static constexpr int value = irsdk_float;
+    };
+    template <>
+    struct VarType<double>
+    {
+        static constexpr int value = irsdk_double;
+    };
+
+} // namespace TelemetryVars
+
+/**
+ * @brief Offsets de las variables registradas dentro de una fila de datos
+ *
+ * Bind() resuelve nombre, tipo y tamaño contra la tabla de cabeceras de la fuente
+ * (memoria compartida o .ibt) una vez por conexión. Después, Get() sólo suma un
+ * offset al puntero de la fila actual: sin búsquedas, sin switch de tipo por elemento.
+ */
+class TelemetryVarRegistry
+{
+public:
+    TelemetryVarRegistry() { Unbind(); }
+
+    // Devuelve el número de variables resueltas; las que falten quedan inválidas
+    int Bind(const irsdk_varHeader *varHeaders, int numVars);
+    void Unbind();
+    bool IsBound() const { return m_bound; }
+
+    // Nombre de la variable en el SDK
+    static const char *GetName(TelemetryVars::Id id);
+
+    // Rangos de bytes de las variables resueltas, para irsdk_setCopyRanges(). Devuelve cuántos escribió
+    int BuildCopyRanges(irsdk_copyRange *out, int maxRanges) const;
+
+    // Fila de datos actual (se asume el mismo layout que las cabeceras del último Bind)
+    void SetData(const char *data) { m_data = data; }
+
+    template <typename T, int N>
+    bool Has(const TelemetryVars::Def<T, N> &def) const
+    {
+        return m_offsets[def.id] >= 0;
+    }
+
+    template <typename T, int N>
+    VarSpan<T, N> Get(const TelemetryVars::Def<T, N> &def) const
+    {
+        const int offset = m_offsets[def.id];
+        if (!m_data || offset < 0)
+            return VarSpan<T, N>();
+        return VarSpan<T, N>(reinterpret_cast<const T *>(m_data + offset));
+    }
+
+    template <typename T>
+    T Value(const TelemetryVars::Def<T, 1> &def, T fallback = T()) const
+    {
+        VarSpan<T, 1> span = Get(def);
+        return span.IsValid() ? span[0] : fallback;
+    }
+
+private:
+    int m_offsets[TelemetryVars::COUNT];
+    int m_sizes[TelemetryVars::COUNT]; // Bytes que ocupa cada variable en la fila
+    const char *m_data = nullptr;
+    bool m_bound = false;
+};
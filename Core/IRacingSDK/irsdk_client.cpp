@@ -53,6 +53,10 @@ bool irsdkClient::waitForData(int timeoutMS)
 			if(m_data) delete [] m_data;
 			m_nData = irsdk_getHeader()->bufLen;
 			m_data = new char[m_nData];
+			memset(m_data, 0, m_nData);
+
+			// var offsets may have moved, copy whole rows until the owner subscribes again
+			irsdk_clearCopyRanges();
 
 			// indicate a new connection
 			m_statusID++;
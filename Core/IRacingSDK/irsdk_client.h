@@ -45,6 +45,10 @@ public:
 	bool isConnected();
 	int getStatusID() { return m_statusID; }
 
+	// raw copy of the current data row, laid out as described by irsdk_getVarHeaderPtr()
+	// NULL when not connected, reallocated whenever getStatusID() changes
+	const char *getData() const { return m_data; }
+
 	int getVarIdx(const char *name);
 
 	// what is the base type of the data
@@ -81,12 +81,27 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Constant Definitions
 
+#ifdef _WIN32
 #include <tchar.h>
+#else
+// no tchar.h off Windows, names are plain char
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+typedef char _TCHAR;
+#ifndef _T
+#define _T(x) x
+#endif
+#endif
 
 static const _TCHAR IRSDK_DATAVALIDEVENTNAME[] = _T("Local\\IRSDKDataValidEvent");
 static const _TCHAR IRSDK_MEMMAPFILENAME[]     = _T("Local\\IRSDKMemMapFileName");
 static const _TCHAR IRSDK_BROADCASTMSGNAME[]   = _T("IRSDK_BROADCASTMSG");
 
+// POSIX stand-in for the sim's shared memory (see irsdk_platform.h), shm_open() names
+static const char IRSDK_POSIX_MEMMAPNAME[]     = "/IRSDKMemMapFileName";
+static const char IRSDK_POSIX_DATAVALIDNAME[]  = "/IRSDKDataValidEvent";
+
 static const int IRSDK_MAX_BUFS = 4;
 static const int IRSDK_MAX_STRING = 32;
 // descriptions can be longer than max_string!
@@ -417,6 +432,39 @@ const irsdk_varHeader *irsdk_getVarHeaderEntry(int index);
 int irsdk_varNameToIndex(const char *name);
 int irsdk_varNameToOffset(const char *name);
 
+// Optional subscription mode, by default irsdk_getNewData() copies the whole bufLen row.
+// Register the byte ranges of the variables you read and only those get copied each tick,
+// the rest of the destination buffer is left untouched. Ranges are sorted and merged
+// (including small gaps) into a copy plan. Offsets are only valid for the current
+// connection, so clear the plan and register again whenever the var headers change.
+static const int IRSDK_MAX_COPY_RANGES = 64;
+static const int IRSDK_COPY_MERGE_GAP = 64; // merge ranges closer than this many bytes
+
+struct irsdk_copyRange
+{
+	int offset;
+	int len;
+};
+
+// returns the number of ranges in the resulting plan, 0 = copying full rows
+int irsdk_setCopyRanges(const irsdk_copyRange *ranges, int count);
+void irsdk_clearCopyRanges();
+int irsdk_getCopyBytes(); // bytes copied per tick with the current plan
+
+// Read statistics of irsdk_getNewData(), so the caller can tell a slow reader (ticks
+// skipped) from rows lost because the sim overwrote the buffer while we copied it.
+// Counters are cumulative for the whole process, the last* fields describe the last row read.
+struct irsdk_readStats
+{
+	int reads;          // rows copied
+	int retries;        // copies repeated because the buffer changed mid-copy
+	int tornReads;      // rows dropped, the buffer changed during both attempts
+	int lastRetries;    // 0 or 1
+	long long lastCopyNs; // time spent copying the last row, retries included
+};
+
+const irsdk_readStats *irsdk_getReadStats();
+
 //----
 // Remote controll the sim by sending these windows messages
 // camera and replay commands only work when you are out of your car, 
@@ -480,6 +480,7 @@ irsdkDiskWriter::irsdkDiskWriter()
 	: m_ibtFile(NULL)
 	, m_diskSubHeaderOffset(0)
 	, m_isHeaderFinalized(false)
+	, m_tickRate(60)
 {
 	memset(&m_header, 0, sizeof(m_header));
 	memset(&m_diskSubHeader, 0, sizeof(m_diskSubHeader));
@@ -492,6 +493,7 @@ irsdkDiskWriter::irsdkDiskWriter(const char *path)
 	: m_ibtFile(NULL)
 	, m_diskSubHeaderOffset(0)
 	, m_isHeaderFinalized(false)
+	, m_tickRate(60)
 {
 	memset(&m_header, 0, sizeof(m_header));
 	memset(&m_diskSubHeader, 0, sizeof(m_diskSubHeader));
@@ -607,7 +609,7 @@ void irsdkDiskWriter::finalizeHeader()
 		// main header
 		m_header.ver = 1;
 		m_header.status = irsdk_stConnected;
-		m_header.tickRate = 60;
+		m_header.tickRate = m_tickRate;
 		offset += sizeof(m_header);
 
 		// sub header is written out at end of session
@@ -621,7 +623,8 @@ void irsdkDiskWriter::finalizeHeader()
 
 		// pointer to session info string
 		m_header.sessionInfoUpdate = 0;
-		m_header.sessionInfoLen = (int)strlen(m_sessionInfoString);
+		// include the terminator, irsdkDiskClient overwrites the last byte with one
+		m_header.sessionInfoLen = (int)strlen(m_sessionInfoString) + 1;
 		m_header.sessionInfoOffset = offset;
 		offset += m_header.sessionInfoLen;
 
@@ -642,6 +645,17 @@ void irsdkDiskWriter::finalizeHeader()
 	}
 }
 
+void irsdkDiskWriter::setSessionStr(const char *str)
+{
+	assert(!m_isHeaderFinalized);
+
+	if(str && !m_isHeaderFinalized)
+	{
+		strncpy(m_sessionInfoString, str, MAX_SESSIONSTR_LEN - 1);
+		m_sessionInfoString[MAX_SESSIONSTR_LEN - 1] = '\0';
+	}
+}
+
 // write next line to file and clear buffers
 void irsdkDiskWriter::writeLine()
 {
@@ -84,6 +84,11 @@ public:
 	// get the whole string
 	const char *getSessionStr() { return m_sessionInfoString; }
 
+	// raw access, to republish or re-encode the file without per variable lookups
+	const irsdk_header *getHeader() { return m_ibtFile ? &m_header : NULL; }
+	const irsdk_varHeader *getVarHeaders() { return m_varHeaders; }
+	const char *getData() { return m_varBuf; } // current line, as read by getNextData()
+
 protected:
 
 	irsdk_header m_header;
@@ -165,12 +170,20 @@ public:
 	// get the whole string
 	//char* getSessionStr() { return m_sessionInfoString; }
 
+	// set after openFile() and before finalizeHeader(), defaults are 60 and an empty yaml document
+	void setTickRate(int tickRate) { m_tickRate = tickRate; }
+	void setSessionStr(const char *str);
+
+	// raw access to the current line, laid out as the added variables
+	char *getVarBuf() { return m_varBuf; }
+
 protected:
 
 	irsdk_header m_header;
 	irsdk_diskSubHeader m_diskSubHeader;
 	int m_diskSubHeaderOffset;
 	bool m_isHeaderFinalized;
+	int m_tickRate;
 
 	//****Note, for now static allocate our buffers
 	// could easily aquire these at creation time
@@ -0,0 +1,56 @@
+/*
+MIT License - iRacing Reputation System
+Capa de plataforma bajo irsdk_utils.cpp: memoria compartida, evento de datos y mensajes
+*/
+
+#ifndef IRSDKPLATFORM_H
+#define IRSDKPLATFORM_H
+
+#include "irsdk_defines.h"
+
+// Win32 (irsdk_platform_win32.cpp): the file mapping and event the sim creates.
+// POSIX (irsdk_platform_posix.cpp): shm_open() objects with the same irsdk_header /
+// irsdk_varBuf layout, published by a producer such as telemetry_producer_main.cpp,
+// plus a small event block whose sequence number is waited on with a futex on Linux
+// (polled elsewhere).
+
+//----
+// reader side, used by irsdk_utils.cpp
+
+// map the telemetry memory read only and open the data valid event
+bool irsdkPlatform_open(const char **sharedMem);
+void irsdkPlatform_close();
+// bytes mapped by irsdkPlatform_open(), 0 if not open
+size_t irsdkPlatform_sharedMemSize();
+
+// block until the producer signals new data or timeOutMS elapses
+// returns true if woken by a signal
+bool irsdkPlatform_waitForData(int timeOutMS);
+void irsdkPlatform_sleep(int timeOutMS);
+
+unsigned int irsdkPlatform_registerBroadcastMsg();
+void irsdkPlatform_sendBroadcastMsg(unsigned int msgId, int wParam, int lParam);
+
+// monotonic clock in nanoseconds, shared between processes on the same machine
+long long irsdkPlatform_nowNs();
+// irsdkPlatform_nowNs() of the producer's last signal, 0 if the platform can't tell
+long long irsdkPlatform_lastSignalNs();
+
+//----
+// read only mapping of a whole file (.ibt), independent of the telemetry memory
+
+// returns NULL if the file can't be opened or is empty
+const char *irsdkPlatform_mapFile(const char *path, size_t *size);
+void irsdkPlatform_unmapFile(const char *data, size_t size);
+
+//----
+// producer side, only available on POSIX (on Windows the sim owns these objects)
+
+// create the shared memory, or reuse it from a previous producer (grown to at least
+// the given size), returns it writable
+char *irsdkPlatform_createSharedMem(int size);
+void irsdkPlatform_destroySharedMem();
+// wake every reader blocked in irsdkPlatform_waitForData()
+void irsdkPlatform_signalData();
+
+#endif // IRSDKPLATFORM_H
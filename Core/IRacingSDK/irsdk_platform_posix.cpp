@@ -0,0 +1,261 @@
+/*
+MIT License - iRacing Reputation System
+Capa de plataforma del SDK - Implementación POSIX (memoria compartida + futex)
+*/
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "irsdk_platform.h"
+
+// Stand-in for the Win32 "data valid" event. The producer bumps seq after every row
+// it publishes; readers remember the last value they saw, so a signal that arrives
+// between the data check and the wait is never lost.
+struct irsdkPosixEventBlock
+{
+	std::atomic<uint32_t> seq;
+	uint32_t pad;
+	std::atomic<long long> signalNs;
+};
+
+static const char *pSharedMem = NULL;
+static size_t sharedMemLen = 0;
+static irsdkPosixEventBlock *pEvent = NULL;
+static uint32_t lastSeq = 0;
+
+// producer side
+static char *pOwnedMem = NULL;
+static size_t ownedMemLen = 0;
+static irsdkPosixEventBlock *pOwnedEvent = NULL;
+
+static void *mapObject(const char *name, bool writable, size_t *len)
+{
+	int fd = shm_open(name, writable ? O_RDWR : O_RDONLY, 0);
+	if(fd < 0)
+		return NULL;
+
+	struct stat st;
+	void *mem = MAP_FAILED;
+	if(fstat(fd, &st) == 0 && st.st_size > 0)
+		mem = mmap(NULL, (size_t)st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if(mem == MAP_FAILED)
+		return NULL;
+
+	*len = (size_t)st.st_size;
+	return mem;
+}
+
+// Like the sim's file mapping on Win32 the object keeps its name across producer
+// restarts, so a reader still holding the old mapping sees the new data. It only
+// ever grows: shrinking it would fault readers that mapped the larger size.
+static void *createObject(const char *name, size_t len)
+{
+	int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+	if(fd < 0)
+		return NULL;
+
+	struct stat st;
+	void *mem = MAP_FAILED;
+	if(fstat(fd, &st) == 0 && ((size_t)st.st_size >= len || ftruncate(fd, (off_t)len) == 0))
+		mem = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	return mem == MAP_FAILED ? NULL : mem;
+}
+
+bool irsdkPlatform_open(const char **sharedMem)
+{
+	if(!pSharedMem)
+		pSharedMem = (const char *)mapObject(IRSDK_POSIX_MEMMAPNAME, false, &sharedMemLen);
+
+	if(pSharedMem)
+	{
+		if(!pEvent)
+		{
+			size_t len = 0;
+			pEvent = (irsdkPosixEventBlock *)mapObject(IRSDK_POSIX_DATAVALIDNAME, false, &len);
+			if(pEvent && len < sizeof(irsdkPosixEventBlock))
+			{
+				munmap(pEvent, len);
+				pEvent = NULL;
+			}
+			if(pEvent)
+				lastSeq = pEvent->seq.load(std::memory_order_acquire);
+		}
+
+		if(pEvent)
+		{
+			*sharedMem = pSharedMem;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+size_t irsdkPlatform_sharedMemSize()
+{
+	return pSharedMem ? sharedMemLen : 0;
+}
+
+void irsdkPlatform_close()
+{
+	if(pEvent)
+		munmap(pEvent, sizeof(irsdkPosixEventBlock));
+
+	if(pSharedMem)
+		munmap((void *)pSharedMem, sharedMemLen);
+
+	pEvent = NULL;
+	pSharedMem = NULL;
+	sharedMemLen = 0;
+}
+
+bool irsdkPlatform_waitForData(int timeOutMS)
+{
+	if(!pEvent)
+	{
+		irsdkPlatform_sleep(timeOutMS);
+		return false;
+	}
+
+	uint32_t cur = pEvent->seq.load(std::memory_order_acquire);
+	if(cur == lastSeq && timeOutMS > 0)
+	{
+#ifdef __linux__
+		struct timespec ts;
+		ts.tv_sec = timeOutMS / 1000;
+		ts.tv_nsec = (long)(timeOutMS % 1000) * 1000000L;
+		// shared (not private) futex, the event block lives in another process' mapping
+		syscall(SYS_futex, (uint32_t *)&pEvent->seq, FUTEX_WAIT, cur, &ts, NULL, 0);
+#else
+		// no futex, poll at 1ms
+		for(int waited = 0; waited < timeOutMS && pEvent->seq.load(std::memory_order_acquire) == cur; waited++)
+			irsdkPlatform_sleep(1);
+#endif
+		cur = pEvent->seq.load(std::memory_order_acquire);
+	}
+
+	bool signaled = cur != lastSeq;
+	lastSeq = cur;
+	return signaled;
+}
+
+void irsdkPlatform_sleep(int timeOutMS)
+{
+	struct timespec ts;
+	ts.tv_sec = timeOutMS / 1000;
+	ts.tv_nsec = (long)(timeOutMS % 1000) * 1000000L;
+	nanosleep(&ts, NULL);
+}
+
+unsigned int irsdkPlatform_registerBroadcastMsg()
+{
+	// no sim to talk to
+	return 0;
+}
+
+void irsdkPlatform_sendBroadcastMsg(unsigned int, int, int)
+{
+}
+
+long long irsdkPlatform_nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+long long irsdkPlatform_lastSignalNs()
+{
+	return pEvent ? pEvent->signalNs.load(std::memory_order_acquire) : 0;
+}
+
+const char *irsdkPlatform_mapFile(const char *path, size_t *size)
+{
+	int fd = open(path, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+
+	struct stat st;
+	void *mem = MAP_FAILED;
+	if(fstat(fd, &st) == 0 && st.st_size > 0)
+		mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(mem == MAP_FAILED)
+		return NULL;
+
+	*size = (size_t)st.st_size;
+	return (const char *)mem;
+}
+
+void irsdkPlatform_unmapFile(const char *data, size_t size)
+{
+	if(data)
+		munmap((void *)data, size);
+}
+
+char *irsdkPlatform_createSharedMem(int size)
+{
+	irsdkPlatform_destroySharedMem();
+
+	pOwnedMem = (char *)createObject(IRSDK_POSIX_MEMMAPNAME, (size_t)size);
+	if(!pOwnedMem)
+		return NULL;
+	ownedMemLen = (size_t)size;
+
+	pOwnedEvent = (irsdkPosixEventBlock *)createObject(IRSDK_POSIX_DATAVALIDNAME, sizeof(irsdkPosixEventBlock));
+	if(!pOwnedEvent)
+	{
+		irsdkPlatform_destroySharedMem();
+		return NULL;
+	}
+
+	// a fresh object is zero filled; a reused one keeps counting from the old seq,
+	// readers only compare it against the last value they saw
+	return pOwnedMem;
+}
+
+void irsdkPlatform_destroySharedMem()
+{
+	// no shm_unlink: connected readers keep their mapping and pick up the next producer
+	if(pOwnedEvent)
+		munmap(pOwnedEvent, sizeof(irsdkPosixEventBlock));
+
+	if(pOwnedMem)
+		munmap(pOwnedMem, ownedMemLen);
+
+	pOwnedEvent = NULL;
+	pOwnedMem = NULL;
+	ownedMemLen = 0;
+}
+
+void irsdkPlatform_signalData()
+{
+	if(!pOwnedEvent)
+		return;
+
+	// timestamp first, so a reader that sees the new seq also sees its time
+	pOwnedEvent->signalNs.store(irsdkPlatform_nowNs(), std::memory_order_release);
+	pOwnedEvent->seq.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+	syscall(SYS_futex, (uint32_t *)&pOwnedEvent->seq, FUTEX_WAKE, 0x7fffffff, NULL, NULL, 0);
+#endif
+}
+
+#endif // !_WIN32
@@ -0,0 +1,166 @@
+/*
+MIT License - iRacing Reputation System
+Capa de plataforma del SDK - Implementación Win32 (la de iRacing)
+*/
+
+#ifdef _WIN32
+
+#define MIN_WIN_VER 0x0501
+
+#ifndef WINVER
+#	define WINVER			MIN_WIN_VER
+#endif
+
+#ifndef _WIN32_WINNT
+#	define _WIN32_WINNT		MIN_WIN_VER
+#endif
+
+#include <windows.h>
+
+#include "irsdk_platform.h"
+
+// for timeBeginPeriod()
+#pragma comment(lib, "Winmm")
+// for RegisterWindowMessage() and SendMessage()
+#pragma comment(lib, "User32")
+
+static HANDLE hDataValidEvent = NULL;
+static HANDLE hMemMapFile = NULL;
+static const char *pSharedMem = NULL;
+
+bool irsdkPlatform_open(const char **sharedMem)
+{
+	if(!hMemMapFile)
+		hMemMapFile = OpenFileMapping( FILE_MAP_READ, FALSE, IRSDK_MEMMAPFILENAME);
+
+	if(hMemMapFile)
+	{
+		if(!pSharedMem)
+			pSharedMem = (const char *)MapViewOfFile(hMemMapFile, FILE_MAP_READ, 0, 0, 0);
+
+		if(pSharedMem)
+		{
+			if(!hDataValidEvent)
+				hDataValidEvent = OpenEvent(SYNCHRONIZE, false, IRSDK_DATAVALIDEVENTNAME);
+
+			if(hDataValidEvent)
+			{
+				*sharedMem = pSharedMem;
+				return true;
+			}
+			//else printf("Error opening event: %d\n", GetLastError());
+		}
+		//else printf("Error mapping file: %d\n", GetLastError());
+	}
+	//else printf("Error opening file: %d\n", GetLastError());
+
+	return false;
+}
+
+size_t irsdkPlatform_sharedMemSize()
+{
+	// the view covers the whole mapping, its region size is the mapped length
+	MEMORY_BASIC_INFORMATION info;
+	if(pSharedMem && VirtualQuery(pSharedMem, &info, sizeof(info)) == sizeof(info))
+		return info.RegionSize;
+	return 0;
+}
+
+void irsdkPlatform_close()
+{
+	if(hDataValidEvent)
+		CloseHandle(hDataValidEvent);
+
+	if(pSharedMem)
+		UnmapViewOfFile(pSharedMem);
+
+	if(hMemMapFile)
+		CloseHandle(hMemMapFile);
+
+	hDataValidEvent = NULL;
+	pSharedMem = NULL;
+	hMemMapFile = NULL;
+}
+
+bool irsdkPlatform_waitForData(int timeOutMS)
+{
+	return WaitForSingleObject(hDataValidEvent, timeOutMS) == WAIT_OBJECT_0;
+}
+
+void irsdkPlatform_sleep(int timeOutMS)
+{
+	Sleep(timeOutMS);
+}
+
+unsigned int irsdkPlatform_registerBroadcastMsg()
+{
+	return RegisterWindowMessage(IRSDK_BROADCASTMSGNAME);
+}
+
+void irsdkPlatform_sendBroadcastMsg(unsigned int msgId, int wParam, int lParam)
+{
+	SendNotifyMessage(HWND_BROADCAST, msgId, wParam, lParam);
+}
+
+long long irsdkPlatform_nowNs()
+{
+	static LARGE_INTEGER freq = {};
+	if(freq.QuadPart == 0)
+		QueryPerformanceFrequency(&freq);
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return (long long)((double)now.QuadPart * 1.0e9 / (double)freq.QuadPart);
+}
+
+long long irsdkPlatform_lastSignalNs()
+{
+	// the sim's event carries no timestamp
+	return 0;
+}
+
+char *irsdkPlatform_createSharedMem(int)
+{
+	return NULL;
+}
+
+const char *irsdkPlatform_mapFile(const char *path, size_t *size)
+{
+	HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+	if(hFile == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	const char *data = NULL;
+	LARGE_INTEGER len;
+	if(GetFileSizeEx(hFile, &len) && len.QuadPart > 0)
+	{
+		HANDLE hMap = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if(hMap)
+		{
+			data = (const char *)MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+			// the view keeps the mapping alive
+			CloseHandle(hMap);
+		}
+	}
+	CloseHandle(hFile);
+
+	if(data)
+		*size = (size_t)len.QuadPart;
+	return data;
+}
+
+void irsdkPlatform_unmapFile(const char *data, size_t size)
+{
+	if(data)
+		UnmapViewOfFile(data);
+}
+
+void irsdkPlatform_destroySharedMem()
+{
+}
+
+void irsdkPlatform_signalData()
+{
+}
+
+#endif // _WIN32
@@ -25,18 +25,8 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#define MIN_WIN_VER 0x0501
-
-#ifndef WINVER
-#	define WINVER			MIN_WIN_VER
-#endif
-
-#ifndef _WIN32_WINNT
-#	define _WIN32_WINNT		MIN_WIN_VER 
-#endif
-
-#include <windows.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <limits.h>
 
@@ -45,16 +35,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "irsdk_defines.h"
-
-// for timeBeginPeriod()
-#pragma comment(lib, "Winmm")
-// for RegisterWindowMessage() and SendMessage()
-#pragma comment(lib, "User32")
+#include "irsdk_platform.h"
 
 // Local memory
-
-static HANDLE hDataValidEvent = NULL;
-static HANDLE hMemMapFile = NULL;
+// the OS specific handles live in irsdk_platform_win32.cpp / irsdk_platform_posix.cpp
 
 static const char *pSharedMem = NULL;
 static const irsdk_header *pHeader = NULL;
@@ -65,66 +49,59 @@ static bool isInitialized = false;
 static const double timeout = 30.0; // timeout after 30 seconds with no communication
 static time_t lastValidTime = 0;
 
-// Function Implementations
+// subscription copy plan, sorted by offset and non overlapping
+static irsdk_copyRange copyPlan[IRSDK_MAX_COPY_RANGES];
+static int copyPlanCount = 0;
 
-bool irsdk_startup()
+static irsdk_readStats readStats = {};
+
+static void copyRow(char *data, const char *src, int bufLen)
 {
-	if(!hMemMapFile)
+	if(copyPlanCount == 0)
 	{
-		hMemMapFile = OpenFileMapping( FILE_MAP_READ, FALSE, IRSDK_MEMMAPFILENAME);
-		lastTickCount = INT_MAX;
+		memcpy(data, src, bufLen);
+		return;
 	}
 
-	if(hMemMapFile)
+	for(int i = 0; i < copyPlanCount; i++)
 	{
-		if(!pSharedMem)
+		const irsdk_copyRange &r = copyPlan[i];
+		if(r.offset >= bufLen)
+			break;
+		int len = (r.offset + r.len <= bufLen) ? r.len : bufLen - r.offset;
+		memcpy(data + r.offset, src + r.offset, len);
+	}
+}
+
+// Function Implementations
+
+bool irsdk_startup()
+{
+	if(!pSharedMem)
+	{
+		if(irsdkPlatform_open(&pSharedMem))
 		{
-			pSharedMem = (const char *)MapViewOfFile(hMemMapFile, FILE_MAP_READ, 0, 0, 0);
 			pHeader = (irsdk_header *)pSharedMem;
 			lastTickCount = INT_MAX;
 		}
-
-		if(pSharedMem)
-		{
-			if(!hDataValidEvent)
-			{
-				hDataValidEvent = OpenEvent(SYNCHRONIZE, false, IRSDK_DATAVALIDEVENTNAME);
-				lastTickCount = INT_MAX;
-			}
-
-			if(hDataValidEvent)
-			{
-				isInitialized = true;
-				return isInitialized;
-			}
-			//else printf("Error opening event: %d\n", GetLastError()); 
-		}
-		//else printf("Error mapping file: %d\n", GetLastError()); 
+		else
+			pSharedMem = NULL;
 	}
-	//else printf("Error opening file: %d\n", GetLastError()); 
 
-	isInitialized = false;
+	isInitialized = pSharedMem != NULL;
 	return isInitialized;
 }
 
 void irsdk_shutdown()
 {
-	if(hDataValidEvent)
-		CloseHandle(hDataValidEvent);
-
-	if(pSharedMem)
-		UnmapViewOfFile(pSharedMem);
+	irsdkPlatform_close();
 
-	if(hMemMapFile)
-		CloseHandle(hMemMapFile);
-
-	hDataValidEvent = NULL;
 	pSharedMem = NULL;
 	pHeader = NULL;
-	hMemMapFile = NULL;
 
 	isInitialized = false;
 	lastTickCount = INT_MAX;
+	copyPlanCount = 0;
 }
 
 bool irsdk_getNewData(char *data)
@@ -142,11 +119,27 @@ bool irsdk_getNewData(char *data)
 			return false;
 		}
 
+		// header from a producer being (re)written, or garbage
+		if(pHeader->numBuf < 1 || pHeader->numBuf > IRSDK_MAX_BUFS || pHeader->bufLen < 0)
+		{
+			irsdk_shutdown();
+			return false;
+		}
+
 		int latest = 0;
 		for(int i=1; i<pHeader->numBuf; i++)
 			if(pHeader->varBuf[latest].tickCount < pHeader->varBuf[i].tickCount)
 			   latest = i;	
 
+		// a restarted producer may have grown the memory past what we mapped,
+		// drop the mapping so the next call maps it again at the new size
+		size_t mapped = irsdkPlatform_sharedMemSize();
+		if(pHeader->varBuf[latest].bufOffset < 0 || (size_t)pHeader->varBuf[latest].bufOffset + (size_t)pHeader->bufLen > mapped)
+		{
+			irsdk_shutdown();
+			return false;
+		}
+
 		// if newer than last recieved, than report new data
 		if(lastTickCount < pHeader->varBuf[latest].tickCount)
 		{
@@ -154,18 +147,25 @@ bool irsdk_getNewData(char *data)
 			if(data)
 			{
 				// try twice to get the data out
+				long long copyStart = irsdkPlatform_nowNs();
 				for(int count = 0; count < 2; count++)
 				{
 					int curTickCount =  pHeader->varBuf[latest].tickCount;
-					memcpy(data, pSharedMem + pHeader->varBuf[latest].bufOffset, pHeader->bufLen);
+					copyRow(data, pSharedMem + pHeader->varBuf[latest].bufOffset, pHeader->bufLen);
 					if(curTickCount ==  pHeader->varBuf[latest].tickCount)
 					{
 						lastTickCount = curTickCount;
 						lastValidTime = time(NULL);
+						readStats.reads++;
+						readStats.retries += count;
+						readStats.lastRetries = count;
+						readStats.lastCopyNs = irsdkPlatform_nowNs() - copyStart;
 						return true;
 					}
 				}
 				// if here, the data changed out from under us.
+				readStats.retries++;
+				readStats.tornReads++;
 				return false;
 			}
 			else
@@ -201,7 +201,7 @@ bool irsdk_waitForDataReady(int timeOut, char *data)
 			return true;
 
 		// sleep till signaled
-		WaitForSingleObject(hDataValidEvent, timeOut);
+		irsdkPlatform_waitForData(timeOut);
 
 		// we woke up, so check for data
 		if(irsdk_getNewData(data))
@@ -212,7 +212,7 @@ bool irsdk_waitForDataReady(int timeOut, char *data)
 
 	// sleep if error
 	if(timeOut > 0)
-		Sleep(timeOut);
+		irsdkPlatform_sleep(timeOut);
 
 	return false;
 }
@@ -329,16 +329,84 @@ int irsdk_varNameToOffset(const char *name)
 	return -1;
 }
 
+int irsdk_setCopyRanges(const irsdk_copyRange *ranges, int count)
+{
+	copyPlanCount = 0;
+	if(!ranges || count <= 0)
+		return 0;
+
+	// insertion sort by offset, the list is short and only built once per connection
+	irsdk_copyRange sorted[IRSDK_MAX_COPY_RANGES];
+	int n = 0;
+	for(int i = 0; i < count; i++)
+	{
+		if(ranges[i].offset < 0 || ranges[i].len <= 0)
+			continue;
+
+		// more ranges than we can hold, fall back to full rows rather than miss data
+		if(n == IRSDK_MAX_COPY_RANGES)
+			return 0;
+
+		int j = n++;
+		while(j > 0 && sorted[j-1].offset > ranges[i].offset)
+		{
+			sorted[j] = sorted[j-1];
+			j--;
+		}
+		sorted[j] = ranges[i];
+	}
+
+	for(int i = 0; i < n; i++)
+	{
+		if(copyPlanCount > 0)
+		{
+			irsdk_copyRange &last = copyPlan[copyPlanCount-1];
+			int lastEnd = last.offset + last.len;
+			if(sorted[i].offset <= lastEnd + IRSDK_COPY_MERGE_GAP)
+			{
+				int end = sorted[i].offset + sorted[i].len;
+				if(end > lastEnd)
+					last.len = end - last.offset;
+				continue;
+			}
+		}
+		copyPlan[copyPlanCount++] = sorted[i];
+	}
+
+	return copyPlanCount;
+}
+
+void irsdk_clearCopyRanges()
+{
+	copyPlanCount = 0;
+}
+
+const irsdk_readStats *irsdk_getReadStats()
+{
+	return &readStats;
+}
+
+int irsdk_getCopyBytes()
+{
+	if(copyPlanCount == 0)
+		return pHeader ? pHeader->bufLen : 0;
+
+	int bytes = 0;
+	for(int i = 0; i < copyPlanCount; i++)
+		bytes += copyPlan[i].len;
+	return bytes;
+}
+
 unsigned int irsdk_getBroadcastMsgID()
 {
-	static unsigned int msgId = RegisterWindowMessage(IRSDK_BROADCASTMSGNAME); 
+	static unsigned int msgId = irsdkPlatform_registerBroadcastMsg();
 
 	return msgId;
 }
 
 void irsdk_broadcastMsg(irsdk_BroadcastMsg msg, int var1, int var2, int var3)
 {
-	irsdk_broadcastMsg(msg, var1, (int)MAKELONG(var2, var3));
+	irsdk_broadcastMsg(msg, var1, (int)((var2 & 0xFFFF) | ((unsigned int)(var3 & 0xFFFF) << 16)));
 }
 
 void irsdk_broadcastMsg(irsdk_BroadcastMsg msg, int var1, float var2)
@@ -355,7 +423,7 @@ void irsdk_broadcastMsg(irsdk_BroadcastMsg msg, int var1, int var2)
 
 	if(msgId && msg >= 0 && msg < irsdk_BroadcastLast)
 	{
-		SendNotifyMessage(HWND_BROADCAST, msgId, MAKELONG(msg, var1), var2);
+		irsdkPlatform_sendBroadcastMsg(msgId, (int)((msg & 0xFFFF) | ((unsigned int)(var1 & 0xFFFF) << 16)), var2);
 	}
 }
 
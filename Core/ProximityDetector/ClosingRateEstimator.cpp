@@ -0,0 +1,93 @@
+/*
+MIT License - iRacing Reputation System
+Velocidad de aproximación y tiempo hasta contacto por coche - Implementaciones
+*/
+
+#include "ClosingRateEstimator.h"
+#include <cmath>
+#include <cstring>
+
+void ClosingRateEstimator::Reset()
+{
+    // El kernel lee siempre el slot más antiguo, también sin historia (windowMask = 0 sólo
+    // anula el resultado si lo leído es finito): la ventana vacía debe estar a cero
+    memset(m_relPct, 0, sizeof(m_relPct));
+    memset(m_valid, 0, sizeof(m_valid));
+    memset(m_time, 0, sizeof(m_time));
+    m_head = 0;
+    m_count = 0;
+    m_playerCarIdx = -1;
+    m_lastTime = 0.0;
+}
+
+void ClosingRateEstimator::Update(CarTelemetryFrame &frame, int playerCarIdx, double sessionTime, float trackLengthMeters)
+{
+    if (playerCarIdx != m_playerCarIdx || sessionTime < m_lastTime || sessionTime - m_lastTime > 2 * WINDOW_SECONDS)
+    {
+        Reset();
+        m_playerCarIdx = playerCarIdx;
+    }
+    m_lastTime = sessionTime;
+
+    const bool playerValid = playerCarIdx >= 0 && playerCarIdx < MAX_CARS && frame.lapDistPct[playerCarIdx] >= 0.0f;
+    const float playerPct = playerValid ? frame.lapDistPct[playerCarIdx] : 0.0f;
+
+    // Muestra más antigua de la ventana; sin historia suficiente dt = 0 y todo sale inválido
+    const int oldest = (m_head - m_count + WINDOW_SLOTS) % WINDOW_SLOTS;
+    const double windowSeconds = m_count > 0 ? sessionTime - m_time[oldest] : 0.0;
+    const float dt = windowSeconds >= MIN_WINDOW_SECONDS ? static_cast<float>(windowSeconds) : 0.0f;
+    const float invDt = dt > 0.0f ? 1.0f / dt : 0.0f;
+    const float windowMask = dt > 0.0f ? 1.0f : 0.0f;
+    const float *oldRel = m_relPct[oldest];
+    const float *oldValid = m_valid[oldest];
+
+    // ¿Toca guardar este tick en la ventana?
+    const bool store = m_count == 0 || sessionTime - m_time[(m_head - 1 + WINDOW_SLOTS) % WINDOW_SLOTS] >= WINDOW_SECONDS / WINDOW_SLOTS;
+    float *newRel = m_relPct[m_head];
+    float *newValid = m_valid[m_head];
+    float scratchRel[MAX_CARS];
+    float scratchValid[MAX_CARS];
+    if (!store)
+    {
+        newRel = scratchRel;
+        newValid = scratchValid;
+    }
+
+    const float *lapDistPct = frame.lapDistPct;
+    const unsigned char *gapValid = frame.gapValid;
+
+    // Bucle sin ramas sobre arrays contiguos, como GapEngine::Compute
+    for (int i = 0; i < MAX_CARS; ++i)
+    {
+        const float delta = lapDistPct[i] - playerPct;
+        const float rel = delta - std::floor(delta + 0.5f);
+        const float valid = gapValid[i] ? 1.0f : 0.0f;
+
+        // Lo que ha avanzado la posición relativa, también llevado a media vuelta
+        const float move = rel - oldRel[i];
+        const float wrappedMove = move - std::floor(move + 0.5f);
+
+        // Positivo = la distancia al jugador se reduce (por delante: rel baja; por detrás: rel sube)
+        const float side = rel >= 0.0f ? 1.0f : -1.0f;
+        const float closingPct = -side * wrappedMove * invDt;
+
+        const float ok = valid * oldValid[i] * windowMask;
+        const float approaching = ok * (closingPct > 0.0f ? 1.0f : 0.0f);
+        const float safeClosing = closingPct * approaching + (1.0f - approaching);
+
+        frame.closingSpeed[i] = ok * closingPct * trackLengthMeters;
+        frame.timeToContact[i] = approaching * (std::abs(rel) / safeClosing) + (1.0f - approaching) * INVALID_TTC;
+
+        // Con la ventana llena el slot nuevo es el más antiguo: ya se ha leído oldRel[i]
+        newRel[i] = rel;
+        newValid[i] = valid;
+    }
+
+    if (newRel == m_relPct[m_head])
+    {
+        m_time[m_head] = sessionTime;
+        m_head = (m_head + 1) % WINDOW_SLOTS;
+        if (m_count < WINDOW_SLOTS)
+            m_count++;
+    }
+}
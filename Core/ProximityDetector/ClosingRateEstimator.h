@@ -0,0 +1,46 @@
+/*
+MIT License - iRacing Reputation System
+Velocidad de aproximación y tiempo hasta contacto por coche - Declaraciones
+*/
+
+#pragma once
+
+#include "../../Utils/Common/Types.h"
+
+/**
+ * @brief Estima, para los 64 coches, a qué ritmo se acercan al jugador y cuánto falta para el contacto
+ *
+ * Guarda una ventana deslizante de posiciones relativas al jugador (CarIdxLapDistPct llevado a
+ * [-0.5, 0.5)) muestreada cada WINDOW_SECONDS / WINDOW_SLOTS de SessionTime, así que la ventana
+ * cubre el mismo tiempo a 60 Hz que a 360 Hz. En cada tick compara con la muestra más antigua:
+ * closingSpeed = lo que se ha reducido la distancia por segundo y timeToContact = distancia
+ * actual / closingSpeed. Las vueltas se resuelven con el mismo redondeo que GapEngine, y el
+ * TTC sale en fracción de vuelta, así que no depende de conocer la longitud de la pista.
+ */
+class ClosingRateEstimator
+{
+public:
+    static constexpr int MAX_CARS = CarTelemetryFrame::MAX_CARS;
+    static constexpr int WINDOW_SLOTS = 8;
+    static constexpr double WINDOW_SECONDS = 0.5;
+    static constexpr double MIN_WINDOW_SECONDS = 0.1; // Con menos historia no se estima
+    static constexpr float INVALID_TTC = 999.0f;      // Mismo valor que CarTelemetryFrame::Reset()
+
+    ClosingRateEstimator() { Reset(); }
+
+    void Reset();
+
+    // Añade el tick a la ventana y rellena frame.closingSpeed y frame.timeToContact.
+    // Requiere GapEngine::Compute() antes (usa gapValid). Se reinicia solo si cambia el
+    // coche del jugador o SessionTime retrocede o salta (nueva sesión, Seek del replay).
+    void Update(CarTelemetryFrame &frame, int playerCarIdx, double sessionTime, float trackLengthMeters);
+
+private:
+    float m_relPct[WINDOW_SLOTS][MAX_CARS]; // Posición relativa al jugador en fracción de vuelta
+    float m_valid[WINDOW_SLOTS][MAX_CARS];  // 1 si el coche tenía datos en esa muestra
+    double m_time[WINDOW_SLOTS];
+    int m_head = 0;  // Siguiente slot a escribir
+    int m_count = 0; // Muestras en la ventana
+    int m_playerCarIdx = -1;
+    double m_lastTime = 0.0;
+};
@@ -0,0 +1,202 @@
+/*
+MIT License - iRacing Reputation System
+Cálculo de gaps en pista respecto al jugador - Implementaciones
+*/
+
+#include "GapEngine.h"
+#include "../IRacingSDK/irsdk_defines.h"
+#include <cmath>
+
+namespace GapEngine
+{
+
+    namespace
+    {
+        // CarIdxEstTime es el tiempo estimado para llegar a la posición actual desde la
+        // línea de meta, así que estTime / lapDistPct aproxima la vuelta de referencia.
+        // Usamos el coche más avanzado en la vuelta para minimizar el error relativo.
+        float EstimateLapTime(const float *lapDistPct, const float *estTime)
+        {
+            float bestPct = 0.0f;
+            float lapTime = 0.0f;
+            for (int i = 0; i < MAX_CARS; ++i)
+            {
+                if (lapDistPct[i] > bestPct && estTime[i] > 0.0f)
+                {
+                    bestPct = lapDistPct[i];
+                    lapTime = estTime[i] / lapDistPct[i];
+                }
+            }
+            return bestPct > 0.05f ? lapTime : 0.0f;
+        }
+
+        bool InRange(const CarTelemetryFrame &frame, int carIdx, float maxMeters, float maxSeconds)
+        {
+            return (maxMeters > 0.0f && std::abs(frame.distanceToPlayer[carIdx]) <= maxMeters) ||
+                   (maxSeconds > 0.0f && std::abs(frame.gapToPlayer[carIdx]) <= maxSeconds);
+        }
+
+        // Con FilterLanes = false el bucle ni siquiera lee onPitRoad/trackSurface: es la
+        // referencia con la que el benchmark mide lo que cuesta el filtro dentro de la pasada
+        template <bool FilterLanes>
+        void ComputeKernel(CarTelemetryFrame &frame, int playerCarIdx, float trackLengthMeters)
+        {
+            const float *lapDistPct = frame.lapDistPct;
+            const float *estTime = frame.estTime;
+            const int *lap = frame.lap;
+            const unsigned char *onPitRoad = frame.onPitRoad;
+            const int *trackSurface = frame.trackSurface;
+
+            const bool playerValid = playerCarIdx >= 0 && playerCarIdx < MAX_CARS && lapDistPct[playerCarIdx] >= 0.0f;
+            const float playerPct = playerValid ? lapDistPct[playerCarIdx] : 0.0f;
+            const float playerEst = playerValid ? estTime[playerCarIdx] : 0.0f;
+            const int playerLap = playerValid ? lap[playerCarIdx] : 0;
+            const float lapTime = EstimateLapTime(lapDistPct, estTime);
+            const float validMask = playerValid ? 1.0f : 0.0f;
+            const unsigned char playerPitRoad = playerValid ? onPitRoad[playerCarIdx] : 0;
+
+            frame.lapTimeEstimate = lapTime;
+
+            // Bucle sin ramas sobre arrays contiguos para que el compilador lo vectorice
+            for (int i = 0; i < MAX_CARS; ++i)
+            {
+                const float pct = lapDistPct[i];
+                const float delta = pct - playerPct;
+
+                // Llevar el delta a [-0.5, 0.5): un coche a 0.98 con el jugador en 0.02 está 0.04 por detrás
+                const float wrap = -std::floor(delta + 0.5f);
+                const float rel = delta + wrap;
+
+                const float gap = (estTime[i] - playerEst) + wrap * lapTime;
+                float valid = (pct >= 0.0f ? 1.0f : 0.0f) * validMask * (i != playerCarIdx ? 1.0f : 0.0f);
+                if (FilterLanes)
+                {
+                    const int surface = trackSurface[i];
+                    valid *= (surface != irsdk_NotInWorld ? 1.0f : 0.0f) * (surface != irsdk_InPitStall ? 1.0f : 0.0f) *
+                             (onPitRoad[i] == playerPitRoad ? 1.0f : 0.0f);
+                }
+
+                frame.distanceToPlayer[i] = valid * (rel * trackLengthMeters) + (1.0f - valid) * INVALID_DISTANCE;
+                frame.gapToPlayer[i] = valid * gap + (1.0f - valid) * INVALID_GAP;
+                frame.lapsDelta[i] = static_cast<int>(valid * (static_cast<float>(lap[i] - playerLap) + delta));
+                frame.isAhead[i] = static_cast<unsigned char>(valid * (rel > 0.0f ? 1.0f : 0.0f));
+                frame.gapValid[i] = static_cast<unsigned char>(valid);
+            }
+        }
+    } // namespace
+
+    void Compute(CarTelemetryFrame &frame, int playerCarIdx, float trackLengthMeters)
+    {
+        ComputeKernel<true>(frame, playerCarIdx, trackLengthMeters);
+    }
+
+    void ComputeUnfiltered(CarTelemetryFrame &frame, int playerCarIdx, float trackLengthMeters)
+    {
+        ComputeKernel<false>(frame, playerCarIdx, trackLengthMeters);
+    }
+
+    void SortByTrackPosition(CarTelemetryFrame &frame, int playerCarIdx)
+    {
+        unsigned char *order = frame.trackOrder;
+        unsigned char listed[MAX_CARS] = {};
+
+        // Orden anterior sin los coches que han salido de pista, y detrás los que han entrado
+        int count = 0;
+        for (int k = 0; k < frame.trackOrderCount; ++k)
+        {
+            const int car = order[k];
+            if (frame.lapDistPct[car] >= 0.0f)
+            {
+                order[count++] = static_cast<unsigned char>(car);
+                listed[car] = 1;
+            }
+        }
+        for (int i = 0; i < MAX_CARS; ++i)
+        {
+            if (!listed[i] && frame.lapDistPct[i] >= 0.0f)
+                order[count++] = static_cast<unsigned char>(i);
+        }
+
+        // Inserción: sólo se mueven los adelantamientos y quien cruza la línea de meta
+        for (int k = 1; k < count; ++k)
+        {
+            const unsigned char car = order[k];
+            const float pct = frame.lapDistPct[car];
+            int j = k - 1;
+            while (j >= 0 && frame.lapDistPct[order[j]] > pct)
+            {
+                order[j + 1] = order[j];
+                --j;
+            }
+            order[j + 1] = car;
+        }
+
+        frame.trackOrderCount = count;
+        frame.playerOrderPos = -1;
+        for (int k = 0; k < count; ++k)
+        {
+            if (order[k] == playerCarIdx)
+            {
+                frame.playerOrderPos = k;
+                break;
+            }
+        }
+    }
+
+    void FindNearby(const CarTelemetryFrame &frame, float maxMeters, float maxSeconds, NearbyCars &out)
+    {
+        out.aheadCount = 0;
+        out.behindCount = 0;
+
+        const int count = frame.trackOrderCount;
+        const int start = frame.playerOrderPos;
+        if (start < 0 || count < 2)
+            return;
+
+        // Hacia delante hasta media vuelta (distanceToPlayer cambia de signo). Un coche en el
+        // mismo punto que el jugador no está "por delante" (isAhead = 0): cuenta detrás, y
+        // como su distancia es 0 sigue siendo el primero de esa lista.
+        int forward = 1;
+        for (; forward < count; ++forward)
+        {
+            const int car = frame.trackOrder[(start + forward) % count];
+            if (!frame.gapValid[car])
+                continue;
+            if (frame.distanceToPlayer[car] < 0.0f || !InRange(frame, car, maxMeters, maxSeconds))
+                break;
+
+            if (frame.isAhead[car])
+                out.ahead[out.aheadCount++] = car;
+            else
+                out.behind[out.behindCount++] = car;
+        }
+
+        // Hacia atrás hasta media vuelta, sin volver a los coches que ya vio el recorrido anterior
+        for (int step = 1; step < count - forward + 1; ++step)
+        {
+            const int car = frame.trackOrder[(start - step + count) % count];
+            if (!frame.gapValid[car])
+                continue;
+            if (frame.isAhead[car] || !InRange(frame, car, maxMeters, maxSeconds))
+                break;
+
+            out.behind[out.behindCount++] = car;
+        }
+    }
+
+    int MergeByDistance(const CarTelemetryFrame &frame, const NearbyCars &nearby, int *out)
+    {
+        int a = 0;
+        int b = 0;
+        int n = 0;
+        while (a < nearby.aheadCount || b < nearby.behindCount)
+        {
+            const bool takeAhead = b >= nearby.behindCount ||
+                                   (a < nearby.aheadCount && std::abs(frame.distanceToPlayer[nearby.ahead[a]]) <=
+                                                                 std::abs(frame.distanceToPlayer[nearby.behind[b]]));
+            out[n++] = takeAhead ? nearby.ahead[a++] : nearby.behind[b++];
+        }
+        return n;
+    }
+
+} // namespace GapEngine
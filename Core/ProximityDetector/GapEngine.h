@@ -0,0 +1,55 @@
+/*
+MIT License - iRacing Reputation System
+Cálculo de gaps en pista respecto al jugador - Declaraciones
+*/
+
+#pragma once
+
+#include "../../Utils/Common/Types.h"
+
+namespace GapEngine
+{
+
+    static constexpr int MAX_CARS = CarTelemetryFrame::MAX_CARS;
+    static constexpr float INVALID_GAP = 999.0f;       // Mismo valor que CarTelemetryFrame::Reset()
+    static constexpr float INVALID_DISTANCE = 9999.0f; // Mismo valor que CarTelemetryFrame::Reset()
+
+    // Calcula gaps y distancias para los 64 coches en una sola pasada sin ramas.
+    // Lee lapDistPct, lap y estTime del frame tal y como los publica el SDK
+    // (lapDistPct < 0 = coche fuera del mundo) y rellena gapToPlayer, distanceToPlayer,
+    // lapsDelta, isAhead, gapValid y lapTimeEstimate. La distancia se toma por el camino
+    // más corto en pista, así que un coche justo al otro lado de la línea de meta sale cerca.
+    // En la misma pasada descarta (gapValid = 0) los coches que no pueden cruzarse con el
+    // jugador: fuera del mundo o en su box según trackSurface, o en distinto carril que él
+    // (uno en pit road y el otro en pista) según onPitRoad. Los que se salen de pista cuentan.
+    void Compute(CarTelemetryFrame &frame, int playerCarIdx, float trackLengthMeters);
+
+    // Compute() sin el filtro de pit road y superficie; referencia para el benchmark
+    void ComputeUnfiltered(CarTelemetryFrame &frame, int playerCarIdx, float trackLengthMeters);
+
+    // Ordena los coches en pista por lapDistPct en frame.trackOrder y sitúa al jugador en
+    // frame.playerOrderPos. Parte del orden del tick anterior (el frame se reutiliza entre
+    // ticks): como casi no cambia, la ordenación por inserción queda en O(n).
+    void SortByTrackPosition(CarTelemetryFrame &frame, int playerCarIdx);
+
+    // Coches cercanos al jugador, del más cercano al más lejano en cada sentido
+    struct NearbyCars
+    {
+        int ahead[MAX_CARS];
+        int behind[MAX_CARS];
+        int aheadCount = 0;
+        int behindCount = 0;
+
+        int Count() const { return aheadCount + behindCount; }
+    };
+
+    // Recorre trackOrder desde el jugador hacia delante y hacia atrás, dando la vuelta a la
+    // línea de meta, y se para en cuanto un coche queda fuera de maxMeters y de maxSeconds
+    // (<= 0 desactiva ese criterio) o a media vuelta. Los coches descartados por Compute() se
+    // saltan sin cortar el recorrido. Requiere Compute() y SortByTrackPosition().
+    void FindNearby(const CarTelemetryFrame &frame, float maxMeters, float maxSeconds, NearbyCars &out);
+
+    // Mezcla ahead y behind en out por distancia absoluta; devuelve el número de coches
+    int MergeByDistance(const CarTelemetryFrame &frame, const NearbyCars &nearby, int *out);
+
+} // namespace GapEngine
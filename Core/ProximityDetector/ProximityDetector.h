@@ -5,56 +5,114 @@ Detector de proximidad entre pilotos
 
 #pragma once
 
-#include "../IRacingSDK/IRacingConnection.h"
+#include "../IRacingSDK/TelemetryReader.h"
+#include "GapEngine.h"
 #include "../../Utils/Common/Types.h"
 #include "../../Utils/Logging/Logger.h"
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+
+// Coches cercanos de un tick: índices y gaps, sin copiar DriverData. Los punteros que
+// devuelve GetDriver() apuntan al roster que guarda el propio resultado.
+struct ProximityResult
+{
+    bool valid = false;    // Hay conexión y al menos un tick
+    uint64_t sequence = 0; // TelemetryTick::sequence del que sale
+    RosterSnapshotPtr roster;
+
+    GapEngine::NearbyCars nearby;                 // Por delante y por detrás, del más cercano al más lejano
+    int carIdx[CarTelemetryFrame::MAX_CARS];      // Ambos lados mezclados por distancia en pista
+    float gap[CarTelemetryFrame::MAX_CARS];       // Gap en segundos de carIdx[i]
+    unsigned char isNearby[CarTelemetryFrame::MAX_CARS]; // Indexado por carIdx
+    int count = 0;
+
+    const DriverData *GetDriver(int i) const { return roster ? roster->FindByCarIdx(carIdx[i]) : nullptr; }
+};
 
 class ProximityDetector
 {
 private:
-    IRacingConnection *m_iracingConnection;
+    const TelemetryReader *m_telemetryReader;
     float m_proximityThreshold; // Gap en segundos
     float m_distanceThreshold;  // Distancia en metros (opcional)
 
-    // Calcular distancia aproximada basada en el gap de tiempo
-    float CalculateApproximateDistance(float timeGap, float avgSpeed = 50.0f) const
-    {
-        // Estimación simple: distancia = tiempo * velocidad promedio
-        // avgSpeed en m/s (50 m/s ≈ 180 km/h, velocidad típica en circuito)
-        return std::abs(timeGap) * avgSpeed;
-    }
+    // Cursor propio en el anillo de frames y último tick leído (sin tick nuevo se reutiliza)
+    mutable TelemetryFrameRing::Cursor m_cursor;
+    mutable TelemetryTick m_tick;
+    mutable bool m_hasTick = false;
+
+    // Resultado del último tick: todas las consultas de ese tick salen de aquí
+    mutable ProximityResult m_result;
 
-    // Verificar si un piloto está dentro del rango de proximidad
-    bool IsDriverNearby(const DriverData &driver, const DriverData &player) const
+    // Verificar si un coche está dentro del rango de proximidad (gapValid ya excluye al jugador)
+    bool IsCarNearby(const CarTelemetryFrame &frame, int carIdx) const
     {
-        if (!driver.isValid || !player.isValid || driver.isPlayer)
+        if (!frame.HasGap(carIdx))
             return false;
 
         // Verificar gap de tiempo
-        float absGap = std::abs(driver.gapToPlayer);
+        float absGap = std::abs(frame.gapToPlayer[carIdx]);
         if (absGap > m_proximityThreshold)
             return false;
 
         // Verificación adicional: estar en vueltas similares o misma vuelta
         // (para evitar que pilotos doblados aparezcan como "cercanos")
-        // Esto se puede implementar cuando tengamos datos de vuelta
+        // Esto se puede implementar con frame.lapsDelta
 
         return true;
     }
 
+    // Trae el último tick y recalcula m_result sólo si hay tick o roster nuevos
+    const ProximityResult &Refresh() const
+    {
+        auto snapshot = m_telemetryReader ? m_telemetryReader->GetSnapshot() : nullptr;
+        if (snapshot && snapshot->status != ConnectionStatus::DISCONNECTED &&
+            m_telemetryReader->GetFrameRing().ReadLatest(m_cursor, m_tick))
+            m_hasTick = true;
+
+        if (!snapshot || snapshot->status == ConnectionStatus::DISCONNECTED || !m_hasTick)
+        {
+            m_result.valid = false;
+            m_result.count = 0;
+            m_result.roster = nullptr;
+            return m_result;
+        }
+
+        if (m_result.valid && m_result.sequence == m_tick.sequence && m_result.roster == snapshot->roster)
+            return m_result;
+
+        const CarTelemetryFrame &frame = m_tick.frame;
+        m_result.valid = true;
+        m_result.sequence = m_tick.sequence;
+        m_result.roster = snapshot->roster;
+
+        GapEngine::FindNearby(frame, 0.0f, m_proximityThreshold, m_result.nearby);
+        m_result.count = GapEngine::MergeByDistance(frame, m_result.nearby, m_result.carIdx);
+
+        std::fill(m_result.isNearby, m_result.isNearby + CarTelemetryFrame::MAX_CARS, 0);
+        for (int i = 0; i < m_result.count; ++i)
+        {
+            m_result.gap[i] = frame.gapToPlayer[m_result.carIdx[i]];
+            m_result.isNearby[m_result.carIdx[i]] = 1;
+        }
+        return m_result;
+    }
+
 public:
-    ProximityDetector(IRacingConnection *iracingConnection, float proximityThreshold = 2.0f)
-        : m_iracingConnection(iracingConnection), m_proximityThreshold(proximityThreshold), m_distanceThreshold(100.0f) // 100 metros por defecto
+    ProximityDetector(const TelemetryReader *telemetryReader, float proximityThreshold = 2.0f)
+        : m_telemetryReader(telemetryReader), m_proximityThreshold(proximityThreshold), m_distanceThreshold(100.0f) // 100 metros por defecto
     {
+        if (m_telemetryReader)
+            m_cursor = m_telemetryReader->GetFrameRing().Subscribe();
         Logger::InfoF("ProximityDetector inicializado con threshold: %.1f segundos", proximityThreshold);
     }
 
     void SetProximityThreshold(float seconds)
     {
         m_proximityThreshold = seconds;
+        m_result.valid = false; // Recalcular con el nuevo umbral
         Logger::InfoF("Threshold de proximidad actualizado a: %.1f segundos", seconds);
     }
 
@@ -67,76 +125,29 @@ public:
     float GetProximityThreshold() const { return m_proximityThreshold; }
     float GetDistanceThreshold() const { return m_distanceThreshold; }
 
-    // Obtener todos los pilotos cerca del jugador
-    std::vector<DriverData> GetNearbyDrivers() const
+    // Pilotos cerca del jugador en el último tick, por delante y por detrás
+    const ProximityResult &GetNearbyDrivers() const
     {
-        std::vector<DriverData> nearbyDrivers;
-
-        if (!m_iracingConnection || !m_iracingConnection->IsConnected())
-            return nearbyDrivers;
-
-        const auto &allDrivers = m_iracingConnection->GetSessionDrivers();
-        const auto &playerData = m_iracingConnection->GetPlayerData();
-
-        if (!playerData.isValid)
-            return nearbyDrivers;
-
-        for (const auto &driver : allDrivers)
-        {
-            if (IsDriverNearby(driver, playerData))
-            {
-                nearbyDrivers.push_back(driver);
-            }
-        }
-
-        // Ordenar por proximidad (más cerca primero)
-        std::sort(nearbyDrivers.begin(), nearbyDrivers.end(),
-                  [](const DriverData &a, const DriverData &b)
-                  {
-                      return std::abs(a.gapToPlayer) < std::abs(b.gapToPlayer);
-                  });
-
-        return nearbyDrivers;
+        return Refresh();
     }
 
-    // Obtener el piloto más cercano
-    DriverData GetClosestDriver() const
+    // Obtener el piloto más cercano (nullptr si no hay ninguno)
+    const DriverData *GetClosestDriver() const
     {
-        auto nearbyDrivers = GetNearbyDrivers();
-        return nearbyDrivers.empty() ? DriverData{} : nearbyDrivers[0];
-    }
-
-    // Obtener pilotos cerca por delante y por detrás por separado
-    std::pair<std::vector<DriverData>, std::vector<DriverData>> GetNearbyDriversSeparated() const
-    {
-        std::vector<DriverData> driversAhead;
-        std::vector<DriverData> driversBehind;
-
-        auto nearbyDrivers = GetNearbyDrivers();
-
-        for (const auto &driver : nearbyDrivers)
-        {
-            if (driver.isAhead)
-                driversAhead.push_back(driver);
-            else
-                driversBehind.push_back(driver);
-        }
-
-        return {driversAhead, driversBehind};
+        const ProximityResult &result = Refresh();
+        return result.count > 0 ? result.GetDriver(0) : nullptr;
     }
 
     // Verificar si un piloto específico está cerca
     bool IsDriverNearby(int customerId) const
     {
-        if (!m_iracingConnection || !m_iracingConnection->IsConnected())
-            return false;
-
-        const DriverData driver = m_iracingConnection->GetDriverByCustomerId(customerId);
-        if (!driver.isValid)
+        const ProximityResult &result = Refresh();
+        if (!result.valid)
             return false;
 
-        const auto &playerData = m_iracingConnection->GetPlayerData();
-        return IsDriverNearby(driver, playerData);
+        const DriverData *driver = result.roster->FindByCustomerId(customerId);
+        return driver && driver->isValid && driver->carIdx >= 0 && driver->carIdx < CarTelemetryFrame::MAX_CARS &&
+               result.isNearby[driver->carIdx];
     }
 
     // Obtener información detallada de proximidad
@@ -146,54 +157,53 @@ public:
         float timeGap = 999.0f;
         float estimatedDistance = 999.0f;
         bool isAhead = false;
-        std::string description;
+        char description[96] = "";
     };
 
     ProximityInfo GetProximityInfo(int customerId) const
     {
         ProximityInfo info;
 
-        if (!m_iracingConnection || !m_iracingConnection->IsConnected())
+        const ProximityResult &result = Refresh();
+        if (!result.valid)
         {
-            info.description = "No conectado a iRacing";
+            snprintf(info.description, sizeof(info.description), "No conectado a iRacing");
             return info;
         }
 
-        const DriverData driver = m_iracingConnection->GetDriverByCustomerId(customerId);
-        if (!driver.isValid)
+        const DriverData *driver = result.roster->FindByCustomerId(customerId);
+        if (!driver || !driver->isValid)
         {
-            info.description = "Piloto no encontrado en sesión";
+            snprintf(info.description, sizeof(info.description), "Piloto no encontrado en sesión");
             return info;
         }
 
-        const auto &playerData = m_iracingConnection->GetPlayerData();
-        if (!playerData.isValid)
+        const CarTelemetryFrame &frame = m_tick.frame;
+        if (!frame.HasGap(driver->carIdx))
         {
-            info.description = "Datos del jugador no válidos";
+            snprintf(info.description, sizeof(info.description), "Datos del jugador no válidos");
             return info;
         }
 
-        info.timeGap = driver.gapToPlayer;
-        info.estimatedDistance = CalculateApproximateDistance(info.timeGap);
-        info.isAhead = driver.isAhead;
-        info.isNearby = IsDriverNearby(driver, playerData);
+        info.timeGap = frame.gapToPlayer[driver->carIdx];
+        info.estimatedDistance = std::abs(frame.distanceToPlayer[driver->carIdx]);
+        info.isAhead = frame.isAhead[driver->carIdx] != 0;
+        info.isNearby = IsCarNearby(frame, driver->carIdx);
 
         // Crear descripción
-        char desc[256];
         if (info.isNearby)
         {
-            snprintf(desc, sizeof(desc), "%.1fs %s (≈%.0fm)",
+            snprintf(info.description, sizeof(info.description), "%.1fs %s (≈%.0fm)",
                      std::abs(info.timeGap),
                      info.isAhead ? "adelante" : "atrás",
                      info.estimatedDistance);
         }
         else
         {
-            snprintf(desc, sizeof(desc), "%.1fs %s - fuera de rango",
+            snprintf(info.description, sizeof(info.description), "%.1fs %s - fuera de rango",
                      std::abs(info.timeGap),
                      info.isAhead ? "adelante" : "atrás");
         }
-        info.description = desc;
 
         return info;
     }
@@ -211,23 +221,18 @@ public:
     ProximityStats GetProximityStats() const
     {
         ProximityStats stats;
-        auto nearbyDrivers = GetNearbyDrivers();
 
-        stats.totalNearbyDrivers = static_cast<int>(nearbyDrivers.size());
+        const ProximityResult &result = Refresh();
+        stats.totalNearbyDrivers = result.count;
+        stats.driversAhead = result.nearby.aheadCount;
+        stats.driversBehind = result.nearby.behindCount;
 
-        for (const auto &driver : nearbyDrivers)
+        if (result.count > 0)
         {
-            if (driver.isAhead)
-                stats.driversAhead++;
-            else
-                stats.driversBehind++;
-
-            float absGap = std::abs(driver.gapToPlayer);
-            if (absGap < stats.closestGap)
-            {
-                stats.closestGap = absGap;
-                stats.closestDriverId = driver.customerId;
-            }
+            // result.carIdx va del más cercano al más lejano
+            stats.closestGap = std::abs(result.gap[0]);
+            const DriverData *closest = result.GetDriver(0);
+            stats.closestDriverId = closest ? closest->customerId : -1;
         }
 
         return stats;
@@ -1,29 +1,138 @@
 #include "OverlayProximityTags.h"
 #include "../External/ImGui/imgui.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
 
 OverlayProximityTagsManager overlayManager;
 
-void OverlayProximityTagsManager::ShowOverlay(int carIdx, const std::string &driverName, const std::vector<TagInfo> &tags, float duration)
+namespace
 {
-    currentOverlay.carIdx = carIdx;
-    currentOverlay.driverName = driverName;
-    currentOverlay.tags = tags;
-    currentOverlay.timestamp = std::chrono::steady_clock::now();
-    currentOverlay.duration = duration;
-    visible = true;
+    // GetWarningColor() devuelve 0xRRGGBBAA
+    ImVec4 ToImVec4(uint32_t rgba)
+    {
+        return ImVec4(((rgba >> 24) & 0xFF) / 255.0f, ((rgba >> 16) & 0xFF) / 255.0f,
+                      ((rgba >> 8) & 0xFF) / 255.0f, (rgba & 0xFF) / 255.0f);
+    }
+
+    bool IsSameWarning(const ProximityTagOverlay &entry, const ProximityCandidate &candidate)
+    {
+        return entry.warning.driver.carIdx == candidate.driver->carIdx &&
+               entry.warning.driver.customerId == candidate.driver->customerId &&
+               entry.warning.reputation.behaviorFlags == candidate.reputation->behaviorFlags;
+    }
+} // namespace
+
+void OverlayProximityTagsManager::UpdateWarnings(const ProximityCandidate *candidates, int count, float duration)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const float elapsed = visible ? std::chrono::duration<float>(now - lastUpdate).count() : 0.0f;
+    lastUpdate = now;
+
+    UpdateLane(ahead, candidates, count, true, duration, elapsed);
+    UpdateLane(behind, candidates, count, false, duration, elapsed);
+    visible = GetWarningCount() > 0;
+}
+
+void OverlayProximityTagsManager::UpdateLane(Lane &lane, const ProximityCandidate *candidates, int count, bool isAhead, float duration,
+                                             float elapsed)
+{
+    // Los más cercanos de este lado, ordenados por gap (inserción: son pocos)
+    int order[MAX_WARNINGS_PER_LANE];
+    int selected = 0;
+    for (int c = 0; c < count; ++c)
+    {
+        if (candidates[c].isAhead != isAhead)
+            continue;
+
+        const float gap = std::abs(candidates[c].gap);
+        int pos = selected < MAX_WARNINGS_PER_LANE ? selected++ : MAX_WARNINGS_PER_LANE;
+        while (pos > 0 && std::abs(candidates[order[pos - 1]].gap) > gap)
+        {
+            if (pos < MAX_WARNINGS_PER_LANE)
+                order[pos] = order[pos - 1];
+            --pos;
+        }
+        if (pos < MAX_WARNINGS_PER_LANE)
+            order[pos] = c;
+    }
+
+    // Diff con las advertencias activas: las que siguen se mueven a su nuevo puesto sin
+    // reconstruirse; sólo las nuevas copian piloto y reputación y calculan su texto
+    Lane next;
+    for (int i = 0; i < selected; ++i)
+    {
+        const ProximityCandidate &candidate = candidates[order[i]];
+        ProximityTagOverlay &entry = next.entries[i];
+
+        int previous = -1;
+        for (int j = 0; j < lane.count && previous < 0; ++j)
+        {
+            if (IsSameWarning(lane.entries[j], candidate))
+                previous = j;
+        }
+
+        if (previous >= 0)
+        {
+            entry = std::move(lane.entries[previous]);
+            entry.warning.timeNearby += elapsed;
+        }
+        else
+        {
+            entry.warning.driver = *candidate.driver;
+            entry.warning.reputation = *candidate.reputation;
+            entry.warning.timeNearby = 0.0f;
+            entry.text = entry.warning.GetWarningText();
+            entry.color = ToImVec4(entry.warning.GetWarningColor());
+            entry.shownGapTenths = -1;
+            entry.timestamp = lastUpdate;
+        }
+
+        entry.warning.gap = candidate.gap;
+        entry.warning.isAhead = isAhead;
+        entry.duration = duration;
+
+        const int tenths = static_cast<int>(std::abs(candidate.gap) * 10.0f + 0.5f);
+        if (tenths != entry.shownGapTenths)
+        {
+            entry.shownGapTenths = tenths;
+            snprintf(entry.gapText, sizeof(entry.gapText), "%s%d.%ds", isAhead ? "+" : "-", tenths / 10, tenths % 10);
+        }
+    }
+    next.count = selected;
+    lane = std::move(next);
 }
 
 void OverlayProximityTagsManager::Update()
 {
     if (!visible)
         return;
+    // Sin actualizaciones durante más de la duración (p. ej. se perdió la conexión), se oculta
     auto now = std::chrono::steady_clock::now();
-    if (std::chrono::duration<float>(now - currentOverlay.timestamp).count() > currentOverlay.duration)
+    const float maxDuration = std::max(ahead.count ? ahead.entries[0].duration : 0.0f,
+                                       behind.count ? behind.entries[0].duration : 0.0f);
+    if (std::chrono::duration<float>(now - lastUpdate).count() > maxDuration)
     {
         Hide();
     }
 }
 
+void OverlayProximityTagsManager::RenderLane(const Lane &lane, const char *title)
+{
+    if (lane.count == 0)
+        return;
+
+    ImGui::TextDisabled("%s", title);
+    for (int i = 0; i < lane.count; ++i)
+    {
+        const ProximityTagOverlay &entry = lane.entries[i];
+        ImGui::TextColored(entry.color, "%s", entry.text.c_str());
+        ImGui::SameLine();
+        ImGui::TextUnformatted(entry.gapText);
+    }
+}
+
 void OverlayProximityTagsManager::Render()
 {
     if (!visible)
@@ -33,18 +142,16 @@ void OverlayProximityTagsManager::Render()
     ImGui::Begin("##ProximityTagsOverlay", nullptr,
                  ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs);
 
-    // driverName sí es std::string, necesitas .c_str()
-    ImGui::Text("%s cerca!", currentOverlay.driverName.c_str());
-
-    for (const auto &tag : currentOverlay.tags)
-    {
-        ImGui::SameLine();
-        ImGui::TextColored(tag.color, "%s", tag.name); // <-- corregido
-    }
+    RenderLane(ahead, "Delante");
+    if (ahead.count > 0 && behind.count > 0)
+        ImGui::Separator();
+    RenderLane(behind, "Detras");
     ImGui::End();
 }
 
 void OverlayProximityTagsManager::Hide()
 {
     visible = false;
+    ahead.count = 0;
+    behind.count = 0;
 }
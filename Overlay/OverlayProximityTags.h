@@ -6,27 +6,56 @@
 #include <chrono>
 #include "../Utils/Common/Types.h"
 
+// Piloto marcado cerca del jugador en este tick. Sólo punteros y números: se compara con
+// las advertencias activas sin copiar strings, y sólo se copia al entrar una advertencia nueva.
+struct ProximityCandidate
+{
+    const DriverData *driver = nullptr;
+    const DriverReputation *reputation = nullptr;
+    float gap = 0.0f;
+    bool isAhead = false;
+};
+
 struct ProximityTagOverlay
 {
-    int carIdx;
-    std::string driverName;
-    std::vector<TagInfo> tags;
-    std::chrono::steady_clock::time_point timestamp;
-    float duration = 3.0f; // segundos
+    ProximityWarning warning;
+    std::string text; // warning.GetWarningText(), calculado al crear la advertencia
+    ImVec4 color;
+    char gapText[16] = "";
+    int shownGapTenths = -1; // Gap mostrado en décimas: gapText sólo se reformatea si cambia
+    std::chrono::steady_clock::time_point timestamp; // Cuándo apareció la advertencia
+    float duration = 3.0f; // Segundos que se mantiene sin actualizaciones
 };
 
 class OverlayProximityTagsManager
 {
 public:
-    void ShowOverlay(int carIdx, const std::string &driverName, const std::vector<TagInfo> &tags, float duration = 3.0f);
+    static constexpr int MAX_WARNINGS_PER_LANE = 3;
+
+    // Sustituye las advertencias por las de este tick: por delante y por detrás, ordenadas
+    // por gap y como mucho MAX_WARNINGS_PER_LANE en cada lado. Las que siguen siendo el mismo
+    // piloto con las mismas flags se conservan (texto, color, tiempo cerca) y sólo actualizan el gap.
+    void UpdateWarnings(const ProximityCandidate *candidates, int count, float duration = 3.0f);
     void Update();
     void Render();
     void Hide();
 
+    int GetWarningCount() const { return ahead.count + behind.count; }
+
 private:
+    struct Lane
+    {
+        ProximityTagOverlay entries[MAX_WARNINGS_PER_LANE];
+        int count = 0;
+    };
+
+    void UpdateLane(Lane &lane, const ProximityCandidate *candidates, int count, bool isAhead, float duration, float elapsed);
+    void RenderLane(const Lane &lane, const char *title);
+
     bool visible = false;
-    ProximityTagOverlay currentOverlay;
+    Lane ahead;
+    Lane behind;
+    std::chrono::steady_clock::time_point lastUpdate;
 };
 
 extern OverlayProximityTagsManager overlayManager;
-extern OverlayProximityTagsManager overlayManager;
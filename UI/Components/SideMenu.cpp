@@ -9,6 +9,7 @@ void SideMenu::Render(float fullHeight, int flaggedCount)
     ImGui::Separator();
     DrawMenuButton("Pilotos registrados", AppView::DRIVERS_WITH_FLAGS, flaggedCount > 0, flaggedCount);
     DrawMenuButton("Sesion Actual", AppView::CURRENT_SESSION);
+    DrawMenuButton("Diagnostico", AppView::DIAGNOSTICS);
     ImGui::EndChild();
 }
 
@@ -4,5 +4,6 @@
 enum class AppView
 {
     DRIVERS_WITH_FLAGS = 0,
-    CURRENT_SESSION = 1
+    CURRENT_SESSION = 1,
+    DIAGNOSTICS = 2
 };
@@ -31,6 +31,7 @@ Ventana independiente para etiquetar pilotos (no overlay)
 // Persistencia SQLite
 #include "../Utils/Persistence/Database.h"
 #include "../Utils/Persistence/ReputationRepository.h"
+#include "../Core/IRacingSDK/AcquisitionStats.h"
 
 // Simple JSON persistencia (manual) para reputaciones
 
@@ -55,7 +56,9 @@ private:
     bool m_visible = false;
     bool m_shouldClose = false;
 
-    // Datos de la sesión actual
+    // Datos de la sesión actual. Con datos reales, m_sessionDrivers se deriva de m_roster y
+    // sólo se reconstruye cuando cambia su versión
+    RosterSnapshotPtr m_roster;
     std::vector<DriverData> m_sessionDrivers;
     std::map<int, DriverReputation> m_driverReputations; // customerId -> reputation (no persistente)
     bool m_usingRealData = false;                        // indica si la lista actual proviene del SDK
@@ -124,6 +127,10 @@ private:
     std::unique_ptr<SideMenu> m_sideMenu;
     void RenderDriversWithFlagsView();
     void RenderCurrentSessionView();
+    void RenderDiagnosticsView();
+
+    // Última copia de la instrumentación del hilo de telemetría (vista Diagnóstico)
+    AcquisitionStats m_acquisitionStats;
 
 public:
     DriverTagWindow() = default;
@@ -139,6 +146,7 @@ public:
     void Hide();
     void Toggle() { m_visible ? Hide() : Show(); }
     bool IsVisible() const { return m_visible; }
+    bool IsForeground() const { return m_hwnd && GetForegroundWindow() == m_hwnd; }
     bool ShouldClose() const { return m_shouldClose; }
     bool IsUsingRealData() const { return m_usingRealData; }
 
@@ -146,7 +154,13 @@ public:
     void UpdateDriverList(const std::vector<DriverData> &drivers);
     void LoadMockData();                                                   // Para pruebas sin iRacing
     void LoadSessionData(const std::vector<DriverData> &sessionDrivers);   // Cargar datos de sesión real
-    void UpdateSessionData(const std::vector<DriverData> &currentDrivers); // Actualizar datos durante sesión
+    void UpdateSessionData(const RosterSnapshotPtr &roster, const CarTelemetryFrame &frame); // Actualizar datos durante sesión
+    void SetAcquisitionStats(const AcquisitionStats &stats) { m_acquisitionStats = stats; }
+    // Guarda un lote de EncounterTracker (source = seguimiento en vivo, windows = tramos que cubre) y lo
+    // suma a las reputaciones en memoria. false = no se guardó (sin base de datos o error): el lote sigue
+    // siendo del llamador
+    bool ApplyEncounters(const std::string &source, const std::vector<SessionWindow> &windows,
+                         const std::vector<EncounterSummary> &encounters);
 
     // Obtener reputación de un piloto
     const DriverReputation *GetDriverReputation(int customerId) const;
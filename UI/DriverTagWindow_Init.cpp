@@ -127,6 +127,7 @@ void DriverTagWindow::Shutdown()
 
 void DriverTagWindow::LoadMockData()
 {
+    m_roster.reset();
     m_sessionDrivers.clear();
     m_usingRealData = false;
     DriverData driver1;
@@ -194,12 +195,14 @@ void DriverTagWindow::LoadMockData()
 
 void DriverTagWindow::UpdateDriverList(const std::vector<DriverData> &drivers)
 {
+    m_roster.reset();
     m_sessionDrivers = drivers;
     Logger::InfoF("Lista de pilotos actualizada: %d pilotos", static_cast<int>(drivers.size()));
 }
 
 void DriverTagWindow::LoadSessionData(const std::vector<DriverData> &sessionDrivers)
 {
+    m_roster.reset();
     m_sessionDrivers = sessionDrivers;
     m_usingRealData = true;
     Logger::Info("Datos de sesión cargados: " + std::to_string(sessionDrivers.size()) + " pilotos");
@@ -209,13 +212,25 @@ void DriverTagWindow::LoadSessionData(const std::vector<DriverData> &sessionDriv
     }
 }
 
-void DriverTagWindow::UpdateSessionData(const std::vector<DriverData> &currentDrivers)
+void DriverTagWindow::UpdateSessionData(const RosterSnapshotPtr &roster, const CarTelemetryFrame &frame)
 {
-    m_sessionDrivers = currentDrivers;
-    m_usingRealData = true;
-    for (const auto &driver : currentDrivers)
+    // La lista y las reputaciones sólo se reconstruyen con un roster nuevo
+    if (!m_roster || m_roster->version != roster->version)
     {
-        GetOrCreateReputation(driver.customerId, driver.displayName);
+        m_roster = roster;
+        m_sessionDrivers = roster->drivers;
+        m_usingRealData = true;
+        for (const auto &driver : m_sessionDrivers)
+        {
+            GetOrCreateReputation(driver.customerId, driver.displayName);
+        }
+    }
+
+    // Entre versiones sólo cambia la posición en vivo: se refresca en sitio
+    for (auto &driver : m_sessionDrivers)
+    {
+        if (driver.carIdx >= 0 && driver.carIdx < CarTelemetryFrame::MAX_CARS)
+            driver.position = frame.position[driver.carIdx];
     }
 }
 
@@ -110,3 +110,31 @@ void DriverTagWindow::FlushDirty(bool force)
     if (flushed > 0)
         Logger::Info("Reputaciones guardadas: " + std::to_string(flushed));
 }
+
+bool DriverTagWindow::ApplyEncounters(const std::string &source, const std::vector<SessionWindow> &windows,
+                                      const std::vector<EncounterSummary> &encounters)
+{
+    if (encounters.empty() && windows.empty())
+        return true;
+    if (!m_persistenceInitialized)
+        return false;
+
+    // La base de datos suma en SQL; la copia en memoria se actualiza igual para que el próximo
+    // Upsert de este piloto (al editar sus tags) no pise los contadores
+    if (!m_repo.MergeSessionEncounters(m_db, source, windows, encounters))
+    {
+        Logger::Warning("Fallo guardando encuentros de " + source);
+        return false;
+    }
+
+    for (const auto &e : encounters)
+    {
+        DriverReputation &rep = GetOrCreateReputation(e.customerId, e.userName);
+        rep.encounterCount += e.encounters;
+        if (e.seen > rep.lastSeen)
+            rep.lastSeen = e.seen;
+    }
+    if (!encounters.empty())
+        Logger::InfoF("Encuentros guardados: %d pilotos (%s)", (int)encounters.size(), source.c_str());
+    return true;
+}
@@ -32,6 +32,9 @@ void DriverTagWindow::Render()
         case AppView::CURRENT_SESSION:
             RenderCurrentSessionView();
             break;
+        case AppView::DIAGNOSTICS:
+            RenderDiagnosticsView();
+            break;
         default:
             ImGui::Text("Vista desconocida");
             break;
@@ -45,3 +45,50 @@ void DriverTagWindow::RenderCurrentSessionView()
         ImGui::Text("Manager no disponible");
     }
 }
+
+void DriverTagWindow::RenderDiagnosticsView()
+{
+    const AcquisitionStats &stats = m_acquisitionStats;
+    ImGui::Text("Adquisicion de telemetria");
+    ImGui::Separator();
+    ImGui::Text("Ticks leidos: %llu a %d Hz", (unsigned long long)stats.ticks, stats.tickRate);
+    ImGui::Text("Perdidos por lectura lenta: %llu   Filas rotas (copia): %llu", (unsigned long long)stats.droppedTicks,
+                (unsigned long long)stats.tornReads);
+    ImGui::Spacing();
+
+    if (ImGui::BeginTable("AcquisitionHistograms", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Metrica");
+        ImGui::TableSetupColumn("n");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("p99.9");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        auto row = [](const char *name, const HdrHistogram &histogram, double unitScale)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", (unsigned long long)histogram.GetCount());
+            const double values[] = {histogram.ValueAtPercentile(50.0) / unitScale, histogram.ValueAtPercentile(99.0) / unitScale,
+                                     histogram.ValueAtPercentile(99.9) / unitScale, histogram.GetMax() / unitScale};
+            for (double value : values)
+            {
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", value);
+            }
+        };
+        row("Hueco entre ticks", stats.tickGap, 1.0);
+        row("Reintentos de copia", stats.retries, 1.0);
+        row("Copia (us)", stats.copyNs, 1000.0);
+        row("Latencia senal->frame (us)", stats.latencyNs, 1000.0);
+        ImGui::EndTable();
+    }
+
+    ImGui::Spacing();
+    if (ImGui::Button("Guardar histogramas (.hgrm)"))
+        stats.WriteToFile("acquisition_stats.hgrm");
+}
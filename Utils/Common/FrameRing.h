@@ -0,0 +1,150 @@
+/*
+MIT License - iRacing Reputation System
+Anillo sin bloqueos de frames preasignados: un productor, lectores independientes
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Anillo de Capacity slots que escribe un único hilo y leen varios a su ritmo
+ *
+ * El productor escribe en el slot de la secuencia n (n % Capacity) sin esperar a
+ * nadie: un lector lento no frena la telemetría, sólo pierde frames. Cada slot lleva
+ * una versión tipo seqlock (impar mientras se escribe, 2n+2 cuando el frame n está
+ * completo); el lector copia el frame y comprueba que la versión no cambió durante la
+ * copia. Cada consumidor guarda su propio Cursor, con la siguiente secuencia que
+ * espera y los frames que se ha perdido por quedarse atrás.
+ *
+ * Nada reserva memoria después de construir el anillo. T debe poder copiarse con memcpy.
+ */
+template <typename T, int Capacity>
+class FrameRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de 2");
+    static_assert(std::is_trivially_copyable<T>::value, "Los frames se copian sin constructores");
+
+public:
+    struct Cursor
+    {
+        uint64_t next = 0;     // Siguiente secuencia a leer
+        uint64_t reads = 0;    // Frames leídos
+        uint64_t overruns = 0; // Frames sobrescritos antes de que este lector llegara a ellos
+    };
+
+    static constexpr int CAPACITY = Capacity;
+
+    // --- Productor (un solo hilo) ---
+
+    // Escribe en sitio el siguiente frame: BeginWrite() + rellenar + EndWrite()
+    T &BeginWrite()
+    {
+        const uint64_t seq = m_head.load(std::memory_order_relaxed);
+        Slot &slot = m_slots[seq & MASK];
+        slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return slot.data;
+    }
+
+    void EndWrite()
+    {
+        const uint64_t seq = m_head.load(std::memory_order_relaxed);
+        m_slots[seq & MASK].version.store(2 * seq + 2, std::memory_order_release);
+        m_head.store(seq + 1, std::memory_order_release);
+    }
+
+    void Push(const T &frame)
+    {
+        BeginWrite() = frame;
+        EndWrite();
+    }
+
+    // Frames publicados desde el principio
+    uint64_t GetWriteCount() const { return m_head.load(std::memory_order_acquire); }
+
+    // --- Consumidores (cada uno con su Cursor) ---
+
+    // Cursor que empieza en el siguiente frame que se publique
+    Cursor Subscribe() const
+    {
+        Cursor cursor;
+        cursor.next = GetWriteCount();
+        return cursor;
+    }
+
+    // Siguiente frame en orden. Si el productor ha dado la vuelta al lector, salta al
+    // más antiguo que sigue en el anillo y cuenta los perdidos. false = no hay frame nuevo
+    bool Read(Cursor &cursor, T &out) const
+    {
+        while (true)
+        {
+            const uint64_t head = GetWriteCount();
+            if (cursor.next >= head)
+                return false;
+
+            if (head - cursor.next > static_cast<uint64_t>(Capacity))
+            {
+                cursor.overruns += head - Capacity - cursor.next;
+                cursor.next = head - Capacity;
+            }
+
+            if (TryCopy(cursor.next, out))
+            {
+                cursor.next++;
+                cursor.reads++;
+                return true;
+            }
+
+            // Sobrescrito mientras lo copiábamos
+            cursor.overruns++;
+            cursor.next++;
+        }
+    }
+
+    // Último frame publicado, saltando los intermedios (no cuentan como perdidos:
+    // el lector ha elegido su ritmo). false = nada nuevo desde la última lectura
+    bool ReadLatest(Cursor &cursor, T &out) const
+    {
+        while (true)
+        {
+            const uint64_t head = GetWriteCount();
+            if (head == 0 || cursor.next >= head)
+                return false;
+
+            if (TryCopy(head - 1, out))
+            {
+                cursor.next = head;
+                cursor.reads++;
+                return true;
+            }
+        }
+    }
+
+private:
+    static constexpr uint64_t MASK = static_cast<uint64_t>(Capacity) - 1;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> version{0};
+        T data;
+    };
+
+    bool TryCopy(uint64_t seq, T &out) const
+    {
+        const Slot &slot = m_slots[seq & MASK];
+        const uint64_t expected = 2 * seq + 2;
+        if (slot.version.load(std::memory_order_acquire) != expected)
+            return false;
+
+        out = slot.data;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.version.load(std::memory_order_relaxed) == expected;
+    }
+
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    Slot m_slots[Capacity];
+};
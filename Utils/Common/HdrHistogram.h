@@ -0,0 +1,147 @@
+/*
+MIT License - iRacing Reputation System
+Histograma log-lineal estilo HDR de tamaño fijo
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Histograma de enteros con error relativo acotado (~3 %) y memoria fija
+ *
+ * Como HdrHistogram: cada potencia de 2 se divide en SUB_BUCKETS cubos lineales, así
+ * que un valor de 20 ns y uno de 20 ms se guardan con la misma precisión relativa.
+ * Los valores menores que SUB_BUCKETS son exactos; los que pasan de 2^MAX_BITS van al
+ * último cubo. Record() no reserva memoria ni bloquea: pensado para el hilo lector.
+ */
+class HdrHistogram
+{
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int MAX_BITS = 40; // ~1.1e12 (18 minutos en ns)
+    static constexpr int BUCKET_COUNT = SUB_BUCKETS + (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+    void Record(uint64_t value)
+    {
+        m_counts[BucketIndex(value)]++;
+        m_total++;
+        m_sum += value;
+        if (value < m_min)
+            m_min = value;
+        if (value > m_max)
+            m_max = value;
+    }
+
+    void Reset() { *this = HdrHistogram(); }
+
+    void Merge(const HdrHistogram &other)
+    {
+        for (int i = 0; i < BUCKET_COUNT; ++i)
+            m_counts[i] += other.m_counts[i];
+        m_total += other.m_total;
+        m_sum += other.m_sum;
+        if (other.m_min < m_min)
+            m_min = other.m_min;
+        if (other.m_max > m_max)
+            m_max = other.m_max;
+    }
+
+    uint64_t GetCount() const { return m_total; }
+    uint64_t GetMin() const { return m_total ? m_min : 0; }
+    uint64_t GetMax() const { return m_max; }
+    double GetMean() const { return m_total ? static_cast<double>(m_sum) / m_total : 0.0; }
+
+    // Valor por debajo del cual queda el percentil p (0-100); límite superior de su cubo
+    uint64_t ValueAtPercentile(double percentile) const
+    {
+        if (m_total == 0)
+            return 0;
+
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * m_total + 0.5);
+        if (target < 1)
+            target = 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; ++i)
+        {
+            seen += m_counts[i];
+            if (seen >= target)
+                return BucketHigh(i) < m_max ? BucketHigh(i) : m_max;
+        }
+        return m_max;
+    }
+
+    // Distribución en el formato de texto de HdrHistogram (.hgrm), con los valores
+    // divididos por unitScale (p. ej. 1000 para pasar de ns a us)
+    void Write(FILE *out, const char *title, double unitScale = 1.0) const
+    {
+        fprintf(out, "# %s\n", title);
+        fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT && m_total > 0; ++i)
+        {
+            if (m_counts[i] == 0)
+                continue;
+            seen += m_counts[i];
+            const double fraction = static_cast<double>(seen) / m_total;
+            const uint64_t high = BucketHigh(i) < m_max ? BucketHigh(i) : m_max;
+            if (fraction < 1.0)
+                fprintf(out, "%12.3f %14.12f %10llu %14.2f\n", high / unitScale, fraction, (unsigned long long)seen,
+                        1.0 / (1.0 - fraction));
+            else
+                fprintf(out, "%12.3f %14.12f %10llu\n", high / unitScale, fraction, (unsigned long long)seen);
+        }
+
+        fprintf(out, "#[Mean    = %12.3f, Max        = %12.3f]\n", GetMean() / unitScale, m_max / unitScale);
+        fprintf(out, "#[Total count    = %12llu]\n\n", (unsigned long long)m_total);
+    }
+
+private:
+    static int HighestBit(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    static int BucketIndex(uint64_t value)
+    {
+        if (value < static_cast<uint64_t>(SUB_BUCKETS))
+            return static_cast<int>(value);
+
+        int shift = HighestBit(value) - SUB_BITS;
+        if (shift > MAX_BITS - SUB_BITS)
+            return BUCKET_COUNT - 1;
+
+        // value >> shift está en [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        return SUB_BUCKETS + shift * SUB_BUCKETS + static_cast<int>((value >> shift) - SUB_BUCKETS);
+    }
+
+    static uint64_t BucketHigh(int index)
+    {
+        if (index < SUB_BUCKETS)
+            return static_cast<uint64_t>(index);
+
+        const int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        const uint64_t low = static_cast<uint64_t>(SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+        return low + (uint64_t(1) << shift) - 1;
+    }
+
+    uint64_t m_counts[BUCKET_COUNT] = {};
+    uint64_t m_total = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = UINT64_MAX;
+    uint64_t m_max = 0;
+};
@@ -7,8 +7,10 @@ Tipos comunes y enumeraciones utilizadas en todo el sistema
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <memory>
 #include <ctime>
+#include <cstdint>
 
 // Forward declarations
 struct ID3D11ShaderResourceView;
@@ -65,17 +67,125 @@ struct DriverData
     std::string licenseString;
     std::string licenseLevel = "D"; // Licencia como string
     float safetyRating = 0.0f;      // Safety Rating
-    int position = 0;
-    float lapDistPct = 0.0f;
+    int position = 0; // Copia para la UI; la posición en vivo está en CarTelemetryFrame
     bool isPlayer = false;
     bool isValid = false;
+};
 
-    // Datos de proximidad
-    float gapToPlayer = 999.0f;    // Gap en segundos
-    float distanceToPlayer = 0.0f; // Distancia en metros
-    bool isAhead = false;
+// Telemetría por coche de un tick, en formato SoA e indexada por carIdx.
+// Se mantiene aparte del roster (DriverData), que sólo cambia con el YAML de sesión,
+// para que el refresco de cada tick no copie strings y los cálculos recorran arrays contiguos.
+struct CarTelemetryFrame
+{
+    static constexpr int MAX_CARS = 64;
+
+    // Datos del SDK
+    int position[MAX_CARS];
+    int lap[MAX_CARS];
+    float lapDistPct[MAX_CARS]; // < 0 = coche fuera del mundo
+    float estTime[MAX_CARS];
+    unsigned char onPitRoad[MAX_CARS]; // CarIdxOnPitRoad
+    int trackSurface[MAX_CARS];        // CarIdxTrackSurface (irsdk_TrkLoc; 3 = en pista si no hay dato)
+
+    // Datos de proximidad respecto al jugador (GapEngine)
+    float gapToPlayer[MAX_CARS];      // Gap en segundos
+    float distanceToPlayer[MAX_CARS]; // Distancia en metros (signo positivo = por delante)
+    int lapsDelta[MAX_CARS];          // Vueltas de diferencia
+    unsigned char isAhead[MAX_CARS];
+    unsigned char gapValid[MAX_CARS]; // 0 para el jugador, coches sin datos y los descartados por pit/superficie
+    float lapTimeEstimate = 0.0f;
+
+    // Aproximación al jugador (ClosingRateEstimator)
+    float closingSpeed[MAX_CARS];  // m/s, positivo = la distancia al jugador se reduce
+    float timeToContact[MAX_CARS]; // Segundos hasta alcanzar al jugador (999 si no se acerca)
+
+    // Coches en pista ordenados por lapDistPct (GapEngine::SortByTrackPosition)
+    unsigned char trackOrder[MAX_CARS];
+    int trackOrderCount = 0;
+    int playerOrderPos = -1; // Posición del jugador en trackOrder (-1 = fuera de pista)
+
+    CarTelemetryFrame() { Reset(); }
+
+    void Reset()
+    {
+        for (int i = 0; i < MAX_CARS; ++i)
+        {
+            position[i] = 0;
+            lap[i] = 0;
+            lapDistPct[i] = -1.0f;
+            estTime[i] = 0.0f;
+            onPitRoad[i] = 0;
+            trackSurface[i] = 3; // irsdk_OnTrack
+            gapToPlayer[i] = 999.0f;
+            distanceToPlayer[i] = 9999.0f;
+            lapsDelta[i] = 0;
+            isAhead[i] = 0;
+            gapValid[i] = 0;
+            closingSpeed[i] = 0.0f;
+            timeToContact[i] = 999.0f;
+        }
+        lapTimeEstimate = 0.0f;
+        trackOrderCount = 0;
+        playerOrderPos = -1;
+    }
+
+    bool HasGap(int carIdx) const
+    {
+        return carIdx >= 0 && carIdx < MAX_CARS && gapValid[carIdx] != 0;
+    }
 };
 
+// Roster de una versión del YAML de sesión. Inmutable una vez creado: se publica como
+// shared_ptr<const RosterSnapshot> y se sustituye entero cuando llega un YAML nuevo, así que
+// los consumidores lo leen sin copiarlo ni bloquear y comparan version para saber si cambió.
+//
+// Los índices se construyen una vez por versión (BuildIndex()) y las búsquedas devuelven
+// punteros al propio roster: válidos mientras se mantenga el shared_ptr.
+struct RosterSnapshot
+{
+    uint64_t version = 0;
+    std::vector<DriverData> drivers;
+
+    RosterSnapshot() { BuildIndex(); }
+
+    void BuildIndex()
+    {
+        for (int i = 0; i < CarTelemetryFrame::MAX_CARS; ++i)
+            m_byCarIdx[i] = -1;
+        m_byCustomerId.clear();
+        m_byCustomerId.reserve(drivers.size());
+
+        for (int i = 0; i < static_cast<int>(drivers.size()); ++i)
+        {
+            const DriverData &driver = drivers[i];
+            if (driver.carIdx >= 0 && driver.carIdx < CarTelemetryFrame::MAX_CARS)
+                m_byCarIdx[driver.carIdx] = i;
+            if (driver.customerId >= 0)
+                m_byCustomerId.emplace(driver.customerId, i);
+        }
+    }
+
+    // nullptr si no hay piloto en ese coche
+    const DriverData *FindByCarIdx(int carIdx) const
+    {
+        if (carIdx < 0 || carIdx >= CarTelemetryFrame::MAX_CARS || m_byCarIdx[carIdx] < 0)
+            return nullptr;
+        return &drivers[m_byCarIdx[carIdx]];
+    }
+
+    const DriverData *FindByCustomerId(int customerId) const
+    {
+        auto it = m_byCustomerId.find(customerId);
+        return it != m_byCustomerId.end() ? &drivers[it->second] : nullptr;
+    }
+
+private:
+    int m_byCarIdx[CarTelemetryFrame::MAX_CARS]; // carIdx -> posición en drivers (-1 = vacío)
+    std::unordered_map<int, int> m_byCustomerId; // customerId -> posición en drivers
+};
+
+using RosterSnapshotPtr = std::shared_ptr<const RosterSnapshot>;
+
 // Estructura de reputación de piloto
 struct DriverReputation
 {
@@ -121,12 +231,38 @@ struct DriverReputation
     }
 };
 
+// Encuentros con un piloto en una sesión grabada (análisis de .ibt)
+struct EncounterSummary
+{
+    int customerId = -1;
+    std::string userName;
+    int encounters = 0;        // Veces que entró en el umbral de proximidad
+    float secondsNear = 0.0f;  // Tiempo total dentro del umbral
+    float closestGap = 999.0f; // |gap| mínimo en segundos
+    int closestLap = 0;        // Vuelta del jugador en ese momento
+    std::string seen;          // Fecha de la sesión (ISO date, UTC)
+};
+
+// Tramo de una sesión que cubre una grabación: SessionNum y rango de SessionTime
+// dentro de la SubSessionID, tal como lo vio el jugador que grabó
+struct SessionWindow
+{
+    int subSessionId = 0;   // 0 en sesiones offline
+    int customerId = 0;     // Jugador que grabó
+    int sessionNum = -1;    // -1 si la grabación no trae SessionNum
+    double startTime = 0.0; // SessionTime, segundos
+    double endTime = 0.0;
+    bool live = false;      // Registrado en vivo (EncounterTracker), no importado de un .ibt
+};
+
 // Estructura para warnings del overlay
 struct ProximityWarning
 {
     DriverData driver;
     DriverReputation reputation;
     float timeNearby = 0.0f; // Tiempo que lleva cerca (segundos)
+    float gap = 0.0f;        // Gap en segundos respecto al jugador
+    bool isAhead = false;
     bool isActive = true;
 
     std::string GetWarningText() const
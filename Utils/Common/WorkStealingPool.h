@@ -0,0 +1,112 @@
+/*
+MIT License - iRacing Reputation System
+Pool de hilos con robo de tareas para trabajos por lotes
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Reparte un lote de tareas entre hilos, cada uno con su propia cola
+ *
+ * Las tareas se reparten en bloques contiguos al empezar; cada hilo consume su cola
+ * por delante y, cuando se queda sin trabajo, roba por detrás de la cola de otro.
+ * Pensado para tareas gruesas y de duración muy desigual (un archivo .ibt por tarea),
+ * así que un mutex por cola es suficiente.
+ */
+class WorkStealingPool
+{
+public:
+    explicit WorkStealingPool(int threadCount = 0)
+        : m_threadCount(threadCount > 0 ? threadCount : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+    {
+    }
+
+    int GetThreadCount() const { return m_threadCount; }
+    uint64_t GetStealCount() const { return m_steals.load(); }
+
+    // Ejecuta task(taskIndex, workerIndex) para cada tarea y vuelve cuando han terminado todas
+    void Run(int taskCount, const std::function<void(int, int)> &task)
+    {
+        const int workers = std::min(m_threadCount, std::max(1, taskCount));
+        std::vector<Queue> queues(workers);
+        for (int w = 0; w < workers; ++w)
+        {
+            const int begin = static_cast<int>(static_cast<int64_t>(taskCount) * w / workers);
+            const int end = static_cast<int>(static_cast<int64_t>(taskCount) * (w + 1) / workers);
+            for (int i = begin; i < end; ++i)
+                queues[w].tasks.push_back(i);
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers);
+        for (int w = 0; w < workers; ++w)
+            threads.emplace_back([this, w, &queues, &task]()
+                                 { WorkerLoop(w, queues, task); });
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    void WorkerLoop(int self, std::vector<Queue> &queues, const std::function<void(int, int)> &task)
+    {
+        const int workers = static_cast<int>(queues.size());
+        int taskIndex;
+        while (true)
+        {
+            if (Pop(queues[self], false, taskIndex))
+            {
+                task(taskIndex, self);
+                continue;
+            }
+
+            // Cola propia vacía: robar empezando por el vecino
+            bool stole = false;
+            for (int k = 1; k < workers && !stole; ++k)
+                stole = Pop(queues[(self + k) % workers], true, taskIndex);
+
+            if (!stole)
+                return; // No se añaden tareas durante Run: si no hay nada que robar, se ha terminado
+
+            m_steals++;
+            task(taskIndex, self);
+        }
+    }
+
+    static bool Pop(Queue &queue, bool fromBack, int &taskIndex)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+
+        if (fromBack)
+        {
+            taskIndex = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            taskIndex = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+
+    int m_threadCount;
+    std::atomic<uint64_t> m_steals{0};
+};
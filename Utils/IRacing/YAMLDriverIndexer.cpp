@@ -0,0 +1,244 @@
+/*
+MIT License - iRacing Reputation System
+Indexador de una sola pasada para DriverInfo:Drivers: - Implementaciones
+*/
+
+#include "YAMLDriverIndexer.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace YAMLDriverIndexer
+{
+
+    namespace
+    {
+        // Busca una clave de nivel superior (columna 0) y devuelve el inicio de la línea siguiente
+        const char *FindTopLevelSection(const char *yaml, const char *key)
+        {
+            const size_t keyLen = strlen(key);
+            const char *line = yaml;
+            while (line && *line)
+            {
+                if (strncmp(line, key, keyLen) == 0)
+                {
+                    const char *next = strchr(line, '\n');
+                    return next ? next + 1 : line + strlen(line);
+                }
+                line = strchr(line, '\n');
+                if (line)
+                    line++;
+            }
+            return nullptr;
+        }
+
+        bool KeyEquals(const char *key, int keyLen, const char *literal)
+        {
+            return (int)strlen(literal) == keyLen && strncmp(key, literal, keyLen) == 0;
+        }
+
+        ValueRef *FieldForKey(DriverEntry &entry, const char *key, int keyLen)
+        {
+            // Despachamos primero por longitud para evitar comparar contra todas las claves
+            switch (keyLen)
+            {
+            case 6:
+                if (KeyEquals(key, keyLen, "CarIdx"))
+                    return &entry.carIdx;
+                if (KeyEquals(key, keyLen, "UserID"))
+                    return &entry.userId;
+                break;
+            case 7:
+                if (KeyEquals(key, keyLen, "IRating"))
+                    return &entry.iRating;
+                break;
+            case 8:
+                if (KeyEquals(key, keyLen, "UserName"))
+                    return &entry.userName;
+                if (KeyEquals(key, keyLen, "LicColor"))
+                    return &entry.licColor;
+                break;
+            case 9:
+                if (KeyEquals(key, keyLen, "CarNumber"))
+                    return &entry.carNumber;
+                if (KeyEquals(key, keyLen, "LicString"))
+                    return &entry.licString;
+                break;
+            case 10:
+                if (KeyEquals(key, keyLen, "CarClassID"))
+                    return &entry.carClassId;
+                break;
+            case 11:
+                if (KeyEquals(key, keyLen, "IsSpectator"))
+                    return &entry.isSpectator;
+                break;
+            case 12:
+                if (KeyEquals(key, keyLen, "CarIsPaceCar"))
+                    return &entry.isPaceCar;
+                break;
+            case 13:
+                if (KeyEquals(key, keyLen, "CarClassColor"))
+                    return &entry.carClassColor;
+                if (KeyEquals(key, keyLen, "CarScreenName"))
+                    return &entry.carScreenName;
+                break;
+            case 22:
+                if (KeyEquals(key, keyLen, "CurDriverIncidentCount"))
+                    return &entry.incidentCount;
+                break;
+            }
+            return nullptr;
+        }
+
+        void CommitEntry(DriverInfoIndex &out, const DriverEntry &entry)
+        {
+            // Igual que la ruta anterior: sin UserName no consideramos que haya piloto
+            if (!entry.carIdx.IsSet() || !entry.userName.IsSet())
+                return;
+
+            int carIdx = entry.carIdx.ToInt(-1);
+            if (carIdx < 0 || carIdx >= MAX_CARS)
+                return;
+
+            if (!out.present[carIdx])
+                out.count++;
+            out.entries[carIdx] = entry;
+            out.present[carIdx] = true;
+        }
+    } // namespace
+
+    int ValueRef::ToInt(int fallback) const
+    {
+        if (!str)
+            return fallback;
+        // El valor termina en fin de línea, atoi se detiene ahí igual que en ParseYamlInt
+        return atoi(str);
+    }
+
+    std::string ValueRef::ToString() const
+    {
+        if (!str)
+            return std::string();
+
+        const char *s = str;
+        int count = len;
+        // strip leading quotes
+        if (count > 0 && *s == '"')
+        {
+            s++;
+            count--;
+        }
+        std::string dest(s, count);
+        // strip trailing quotes
+        if (!dest.empty() && dest.back() == '"')
+            dest.pop_back();
+        return dest;
+    }
+
+    bool IndexDriverInfo(const char *yaml, DriverInfoIndex &out)
+    {
+        out = DriverInfoIndex{};
+
+        if (!yaml)
+            return false;
+
+        const char *p = FindTopLevelSection(yaml, "DriverInfo:");
+        if (!p)
+            return false;
+
+        bool inDrivers = false;
+        bool hasEntry = false;
+        DriverEntry current;
+
+        while (*p)
+        {
+            const char *lineStart = p;
+            int indent = 0;
+            while (*p == ' ')
+            {
+                p++;
+                indent++;
+            }
+
+            // Línea vacía
+            if (*p == '\n' || *p == '\r')
+            {
+                p++;
+                continue;
+            }
+
+            // Una clave en columna 0 cierra la sección DriverInfo:
+            if (p == lineStart && *p != '-')
+                break;
+
+            bool isListItem = false;
+            if (*p == '-')
+            {
+                isListItem = true;
+                p++;
+                while (*p == ' ')
+                    p++;
+            }
+
+            // Clave hasta ':'
+            const char *key = p;
+            while (*p && *p != ':' && *p != '\n' && *p != '\r')
+                p++;
+            int keyLen = (int)(p - key);
+
+            ValueRef value;
+            if (*p == ':')
+            {
+                p++;
+                while (*p == ' ')
+                    p++;
+                value.str = p;
+                while (*p && *p != '\n' && *p != '\r')
+                    p++;
+                value.len = (int)(p - value.str);
+            }
+
+            // Avanzar a la siguiente línea
+            while (*p && *p != '\n')
+                p++;
+            if (*p == '\n')
+                p++;
+
+            if (indent <= 1 && !isListItem)
+            {
+                // Claves directas de DriverInfo:
+                if (hasEntry)
+                {
+                    CommitEntry(out, current);
+                    hasEntry = false;
+                }
+                inDrivers = KeyEquals(key, keyLen, "Drivers");
+                if (KeyEquals(key, keyLen, "DriverCarIdx"))
+                    out.driverCarIdx = value.ToInt(-1);
+                continue;
+            }
+
+            if (!inDrivers)
+                continue;
+
+            if (isListItem)
+            {
+                if (hasEntry)
+                    CommitEntry(out, current);
+                current = DriverEntry{};
+                hasEntry = true;
+            }
+
+            if (hasEntry && value.IsSet())
+            {
+                if (ValueRef *field = FieldForKey(current, key, keyLen))
+                    *field = value;
+            }
+        }
+
+        if (hasEntry)
+            CommitEntry(out, current);
+
+        return out.count > 0;
+    }
+
+} // namespace YAMLDriverIndexer
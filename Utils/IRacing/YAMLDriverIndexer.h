@@ -0,0 +1,58 @@
+/*
+MIT License - iRacing Reputation System
+Indexador de una sola pasada para DriverInfo:Drivers: - Declaraciones
+*/
+
+#pragma once
+
+#include <string>
+
+namespace YAMLDriverIndexer
+{
+
+    static constexpr int MAX_CARS = 64;
+
+    // Referencia sin copia a un valor dentro del string de sesión.
+    // Sólo es válida mientras el string original siga vivo.
+    struct ValueRef
+    {
+        const char *str = nullptr;
+        int len = 0;
+
+        bool IsSet() const { return str != nullptr; }
+        int ToInt(int fallback = 0) const;
+        std::string ToString() const; // Sin comillas, igual que ParseYamlStr
+    };
+
+    // Campos de un elemento de DriverInfo:Drivers: tal y como aparecen en el YAML
+    struct DriverEntry
+    {
+        ValueRef carIdx;
+        ValueRef userName;
+        ValueRef carNumber;
+        ValueRef iRating;
+        ValueRef licString;
+        ValueRef licColor;
+        ValueRef carClassColor;
+        ValueRef carClassId;
+        ValueRef userId;
+        ValueRef incidentCount;
+        ValueRef carScreenName;
+        ValueRef isPaceCar;
+        ValueRef isSpectator;
+    };
+
+    // Resultado del indexado, con una entrada por CarIdx
+    struct DriverInfoIndex
+    {
+        DriverEntry entries[MAX_CARS];
+        bool present[MAX_CARS] = {};
+        int driverCarIdx = -1; // DriverInfo:DriverCarIdx:
+        int count = 0;
+    };
+
+    // Recorre la sección DriverInfo: una única vez y rellena todas las entradas.
+    // Sustituye a las ~13 llamadas a parseYaml por coche, que reescaneaban el string completo.
+    bool IndexDriverInfo(const char *yaml, DriverInfoIndex &out);
+
+} // namespace YAMLDriverIndexer
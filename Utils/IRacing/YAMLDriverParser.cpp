@@ -5,10 +5,12 @@ Parser YAML para información de pilotos de iRacing - Implementaciones
 
 #include "YAMLDriverParser.h"
 #include "StringUtils.h"
+#include "YAMLDriverIndexer.h"
 #include "../../Core/IRacingSDK/yaml_parser.h"
 #include "../../Core/IRacingSDK/irsdk_client.h"
 #include "../Logging/Logger.h"
 #include <algorithm>
+#include <memory>
 
 // Variables externas del SDK de iRacing que necesitamos
 extern irsdkCVar ir_CarIdxPosition;
@@ -49,10 +51,134 @@ namespace YAMLDriverParser
         return false;
     }
 
+    namespace
+    {
+        void CleanUserName(std::string &userName)
+        {
+            // Clean special characters from username (similar a iRon)
+            for (char &c : userName)
+            {
+                if (c == '\n' || c == '\r')
+                    c = ' ';
+                else if ((unsigned char)c < 0x20)
+                    c = ' ';
+            }
+        }
+
+        void ApplyLicense(DriverData &d, const std::string &licenseStr)
+        {
+            d.licenseString = licenseStr;
+            if (!licenseStr.empty())
+            {
+                d.licenseLevel = std::string(1, licenseStr[0]);
+                try
+                {
+                    d.safetyRating = std::stof(licenseStr.substr(1));
+                }
+                catch (...)
+                {
+                    d.safetyRating = 0.0f;
+                }
+            }
+        }
+
+        int ReadPosition(int carIdx)
+        {
+            // Position from telemetry
+            try
+            {
+                return ir_CarIdxPosition.getInt(carIdx);
+            }
+            catch (...)
+            {
+                return 0;
+            }
+        }
+
+        void FilterPlaceholders(std::vector<DriverData> &parsed)
+        {
+            // Filter out pace car
+            parsed.erase(std::remove_if(parsed.begin(), parsed.end(),
+                                        [](const DriverData &d)
+                                        { return d.displayName == "Pace Car"; }),
+                         parsed.end());
+
+            // Filter placeholder drivers that weren't actually parsed
+            size_t before = parsed.size();
+            parsed.erase(std::remove_if(parsed.begin(), parsed.end(),
+                                        [](const DriverData &d)
+                                        {
+                                            if (d.displayName.rfind("Piloto #", 0) != 0)
+                                                return false;
+                                            return d.customerId == d.carIdx + 1000;
+                                        }),
+                         parsed.end());
+
+            size_t removed = before - parsed.size();
+            if (removed > 0)
+                Logger::Info("Placeholders filtrados: " + std::to_string(removed));
+
+            Logger::Info("ParseDriverInfoYAML (estilo iRon): " + std::to_string(parsed.size()) + " pilotos");
+        }
+    } // namespace
+
     std::vector<DriverData> ParseDriverInfoFromYAML(const std::string &yaml, int playerCarIdx)
     {
         std::vector<DriverData> parsed;
 
+        if (yaml.empty())
+            return parsed;
+
+        // Una sola pasada sobre DriverInfo:Drivers: en lugar de un parseYaml por campo
+        auto index = std::make_unique<YAMLDriverIndexer::DriverInfoIndex>();
+        YAMLDriverIndexer::IndexDriverInfo(yaml.c_str(), *index);
+
+        parsed.reserve(index->count);
+
+        for (int carIdx = 0; carIdx < YAMLDriverIndexer::MAX_CARS; ++carIdx)
+        {
+            if (!index->present[carIdx])
+                continue; // No driver at this index
+
+            const YAMLDriverIndexer::DriverEntry &entry = index->entries[carIdx];
+
+            // Skip pace car and spectators
+            if (entry.isPaceCar.ToInt() || entry.isSpectator.ToInt())
+                continue;
+
+            std::string userName = entry.userName.ToString();
+            CleanUserName(userName);
+
+            DriverData d;
+            d.carIdx = carIdx;
+            d.displayName = StringUtils::CP1252ToUTF8(userName);
+            StringUtils::BasicNormalize(d.displayName);
+            d.userName = d.displayName;
+
+            std::string carNumStr = entry.carNumber.ToString();
+            d.carNumber = carNumStr.empty() ? std::to_string(carIdx + 1) : carNumStr;
+
+            d.iRating = entry.iRating.ToInt();
+            ApplyLicense(d, entry.licString.ToString());
+
+            int userID = entry.userId.ToInt(-1);
+            d.customerId = (userID > 0) ? userID : (carIdx + 1000);
+
+            d.position = ReadPosition(carIdx);
+            d.isPlayer = (carIdx == playerCarIdx);
+            d.isValid = true;
+
+            parsed.push_back(std::move(d));
+        }
+
+        FilterPlaceholders(parsed);
+        return parsed;
+    }
+
+    std::vector<DriverData> ParseDriverInfoFromYAMLLegacy(const std::string &yaml, int playerCarIdx)
+    {
+        std::vector<DriverData> parsed;
+
         if (yaml.empty())
             return parsed;
 
@@ -153,8 +279,6 @@ namespace YAMLDriverParser
             int incidentCount = 0;
             sprintf(path, "DriverInfo:Drivers:CarIdx:{%d}CurDriverIncidentCount:", carIdx);
             ParseYamlInt(sessionYaml, path, &incidentCount);
-            // Store in gapToPlayer as temp (could extend DriverData)
-            d.gapToPlayer = static_cast<float>(incidentCount);
 
             // Car name (como en iRon)
             std::string carName;
@@ -190,29 +314,7 @@ namespace YAMLDriverParser
             parsed.push_back(d);
         }
 
-        // Filter out pace car
-        parsed.erase(std::remove_if(parsed.begin(), parsed.end(),
-                                    [](const DriverData &d)
-                                    { return d.displayName == "Pace Car"; }),
-                     parsed.end());
-
-        // Filter placeholder drivers that weren't actually parsed
-        size_t before = parsed.size();
-        parsed.erase(std::remove_if(parsed.begin(), parsed.end(),
-                                    [](const DriverData &d)
-                                    {
-                                        if (d.displayName.rfind("Piloto #", 0) != 0)
-                                            return false;
-                                        return d.customerId == d.carIdx + 1000;
-                                    }),
-                     parsed.end());
-
-        size_t removed = before - parsed.size();
-        if (removed > 0)
-            Logger::Info("Placeholders filtrados: " + std::to_string(removed));
-
-        Logger::Info("ParseDriverInfoYAML (estilo iRon): " + std::to_string(parsed.size()) + " pilotos");
-
+        FilterPlaceholders(parsed);
         return parsed;
     }
 
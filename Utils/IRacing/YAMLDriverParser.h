@@ -15,6 +15,9 @@ namespace YAMLDriverParser
     // Función principal para parsear información de pilotos desde YAML
     std::vector<DriverData> ParseDriverInfoFromYAML(const std::string &yaml, int playerCarIdx);
 
+    // Ruta anterior (un parseYaml por campo y coche). Se conserva sólo como referencia para el benchmark
+    std::vector<DriverData> ParseDriverInfoFromYAMLLegacy(const std::string &yaml, int playerCarIdx);
+
     // Funciones helper para parsing YAML estilo iRon
     bool ParseYamlInt(const char *yamlStr, const char *path, int *dest);
     bool ParseYamlStr(const char *yamlStr, const char *path, std::string &dest);
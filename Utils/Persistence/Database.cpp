@@ -77,6 +77,21 @@ void Database::Finalize(sqlite3_stmt *stmt)
         sqlite3_finalize(stmt);
 }
 
+bool Database::BeginTransaction()
+{
+    return Exec("BEGIN IMMEDIATE;");
+}
+
+bool Database::Commit()
+{
+    return Exec("COMMIT;");
+}
+
+bool Database::Rollback()
+{
+    return Exec("ROLLBACK;");
+}
+
 long long Database::LastInsertId() const
 {
     return sqlite3_last_insert_rowid(m_db);
@@ -21,6 +21,9 @@ public:
     bool Prepare(const std::string &sql, sqlite3_stmt **stmt);
     bool Step(sqlite3_stmt *stmt);
     void Finalize(sqlite3_stmt *stmt);
+    bool BeginTransaction();
+    bool Commit();
+    bool Rollback();
     long long LastInsertId() const;
     int Changes() const;
 
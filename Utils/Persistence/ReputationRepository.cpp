@@ -1,6 +1,7 @@
 #include "ReputationRepository.h"
 #include "../../Utils/Logging/Logger.h"
 #include <sqlite3.h>
+#include <cstring>
 
 bool ReputationRepository::Init(Database &db)
 {
@@ -20,7 +21,61 @@ bool ReputationRepository::EnsureSchema(Database &db)
         last_updated INTEGER,
         trust_score REAL NOT NULL DEFAULT 0.5
     );)";
-    return db.Exec(sql);
+    if (!db.Exec(sql))
+        return false;
+
+    // Un registro por piloto y sesión importada; la clave evita contar dos veces la misma sesión
+    const char *historySql = R"(CREATE TABLE IF NOT EXISTS proximity_history (
+        source TEXT NOT NULL,
+        customer_id INTEGER NOT NULL,
+        encounters INTEGER NOT NULL DEFAULT 0,
+        seconds_near REAL NOT NULL DEFAULT 0,
+        seen TEXT,
+        closest_gap REAL,
+        closest_lap INTEGER,
+        PRIMARY KEY (source, customer_id)
+    );)";
+    if (!db.Exec(historySql))
+        return false;
+
+    // Tramos de sesión de cada grabación, importada o en vivo; la SubSessionID va aparte de la
+    // clave para poder cruzar grabaciones del mismo evento (práctica, clasificación, carrera)
+    const char *windowsSql = R"(CREATE TABLE IF NOT EXISTS session_windows (
+        source TEXT NOT NULL,
+        session_num INTEGER NOT NULL,
+        sub_session_id INTEGER NOT NULL DEFAULT 0,
+        customer_id INTEGER NOT NULL DEFAULT 0,
+        start_time REAL NOT NULL,
+        end_time REAL NOT NULL,
+        live INTEGER NOT NULL DEFAULT 0,
+        PRIMARY KEY (source, session_num)
+    );)";
+    if (!db.Exec(windowsSql))
+        return false;
+
+    // Bases de datos creadas antes de guardar el punto más cercano de cada encuentro
+    if (!HasColumn(db, "proximity_history", "closest_gap") &&
+        !db.Exec("ALTER TABLE proximity_history ADD COLUMN closest_gap REAL"))
+        return false;
+    if (!HasColumn(db, "proximity_history", "closest_lap") &&
+        !db.Exec("ALTER TABLE proximity_history ADD COLUMN closest_lap INTEGER"))
+        return false;
+    return true;
+}
+
+bool ReputationRepository::HasColumn(Database &db, const char *table, const char *column)
+{
+    sqlite3_stmt *stmt = nullptr;
+    if (!db.Prepare(std::string("PRAGMA table_info(") + table + ")", &stmt))
+        return false;
+    bool found = false;
+    while (!found && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const unsigned char *name = sqlite3_column_text(stmt, 1);
+        found = name && strcmp(reinterpret_cast<const char *>(name), column) == 0;
+    }
+    sqlite3_finalize(stmt);
+    return found;
 }
 
 bool ReputationRepository::LoadAll(Database &db, std::map<int, DriverReputation> &out)
@@ -105,3 +160,135 @@ bool ReputationRepository::Upsert(Database &db, const DriverReputation &rep)
     sqlite3_finalize(stmt);
     return true;
 }
+
+bool ReputationRepository::IsSessionImported(Database &db, const std::string &source)
+{
+    // proximity_history cubre las importaciones anteriores a session_windows
+    sqlite3_stmt *stmt = nullptr;
+    if (!db.Prepare("SELECT 1 FROM session_windows WHERE source=?1 UNION ALL SELECT 1 FROM proximity_history WHERE source=?1 LIMIT 1", &stmt))
+        return false;
+    sqlite3_bind_text(stmt, 1, source.c_str(), -1, SQLITE_TRANSIENT);
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+bool ReputationRepository::LoadLiveWindows(Database &db, int subSessionId, int customerId, std::vector<SessionWindow> &out)
+{
+    out.clear();
+    if (subSessionId <= 0)
+        return true;
+
+    sqlite3_stmt *stmt = nullptr;
+    if (!db.Prepare("SELECT session_num,start_time,end_time FROM session_windows WHERE live=1 AND sub_session_id=? AND customer_id=?", &stmt))
+        return false;
+    sqlite3_bind_int(stmt, 1, subSessionId);
+    sqlite3_bind_int(stmt, 2, customerId);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        SessionWindow w;
+        w.subSessionId = subSessionId;
+        w.customerId = customerId;
+        w.sessionNum = sqlite3_column_int(stmt, 0);
+        w.startTime = sqlite3_column_double(stmt, 1);
+        w.endTime = sqlite3_column_double(stmt, 2);
+        w.live = true;
+        out.push_back(w);
+    }
+    sqlite3_finalize(stmt);
+    if (rc != SQLITE_DONE)
+    {
+        Logger::Error("SQLite error leyendo tramos en vivo: " + std::to_string(rc));
+        return false;
+    }
+    return true;
+}
+
+bool ReputationRepository::MergeSessionEncounters(Database &db, const std::string &source, const std::vector<SessionWindow> &windows,
+                                                  const std::vector<EncounterSummary> &encounters)
+{
+    // encounter_count se acumula; last_seen se queda con la fecha más reciente
+    const char *repSql = R"(INSERT INTO driver_reputation (customer_id,user_name,encounter_count,last_seen,last_updated)
+        VALUES (?,?,?,?,?)
+        ON CONFLICT(customer_id) DO UPDATE SET
+          user_name=COALESCE(NULLIF(driver_reputation.user_name,''),excluded.user_name),
+          encounter_count=driver_reputation.encounter_count+excluded.encounter_count,
+          last_seen=MAX(COALESCE(driver_reputation.last_seen,''),excluded.last_seen),
+          last_updated=excluded.last_updated; )";
+    // Una sesión en vivo se guarda en varios lotes con el mismo source: la fila también se acumula
+    // y se queda con el encuentro más cercano (los SET leen los valores anteriores de la fila)
+    const char *historySql = R"(INSERT INTO proximity_history (source,customer_id,encounters,seconds_near,seen,closest_gap,closest_lap)
+        VALUES (?,?,?,?,?,?,?)
+        ON CONFLICT(source,customer_id) DO UPDATE SET
+          encounters=proximity_history.encounters+excluded.encounters,
+          seconds_near=proximity_history.seconds_near+excluded.seconds_near,
+          seen=MAX(COALESCE(proximity_history.seen,''),excluded.seen),
+          closest_lap=CASE WHEN proximity_history.closest_gap IS NULL OR excluded.closest_gap<proximity_history.closest_gap
+                           THEN excluded.closest_lap ELSE proximity_history.closest_lap END,
+          closest_gap=MIN(COALESCE(proximity_history.closest_gap,excluded.closest_gap),excluded.closest_gap); )";
+    // Varios lotes del mismo source amplían el tramo
+    const char *windowSql = R"(INSERT INTO session_windows (source,session_num,sub_session_id,customer_id,start_time,end_time,live)
+        VALUES (?,?,?,?,?,?,?)
+        ON CONFLICT(source,session_num) DO UPDATE SET
+          start_time=MIN(session_windows.start_time,excluded.start_time),
+          end_time=MAX(session_windows.end_time,excluded.end_time); )";
+
+    if (!db.BeginTransaction())
+        return false;
+
+    sqlite3_stmt *repStmt = nullptr;
+    sqlite3_stmt *historyStmt = nullptr;
+    sqlite3_stmt *windowStmt = nullptr;
+    bool ok = db.Prepare(repSql, &repStmt) && db.Prepare(historySql, &historyStmt) && db.Prepare(windowSql, &windowStmt);
+
+    for (size_t i = 0; ok && i < windows.size(); ++i)
+    {
+        const SessionWindow &w = windows[i];
+        sqlite3_bind_text(windowStmt, 1, source.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(windowStmt, 2, w.sessionNum);
+        sqlite3_bind_int(windowStmt, 3, w.subSessionId);
+        sqlite3_bind_int(windowStmt, 4, w.customerId);
+        sqlite3_bind_double(windowStmt, 5, w.startTime);
+        sqlite3_bind_double(windowStmt, 6, w.endTime);
+        sqlite3_bind_int(windowStmt, 7, w.live ? 1 : 0);
+        ok = sqlite3_step(windowStmt) == SQLITE_DONE;
+        sqlite3_reset(windowStmt);
+    }
+
+    const sqlite3_int64 now = (sqlite3_int64)std::time(nullptr);
+    for (size_t i = 0; ok && i < encounters.size(); ++i)
+    {
+        const EncounterSummary &e = encounters[i];
+
+        sqlite3_bind_int(repStmt, 1, e.customerId);
+        sqlite3_bind_text(repStmt, 2, e.userName.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(repStmt, 3, e.encounters);
+        sqlite3_bind_text(repStmt, 4, e.seen.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(repStmt, 5, now);
+        ok = sqlite3_step(repStmt) == SQLITE_DONE;
+        sqlite3_reset(repStmt);
+
+        sqlite3_bind_text(historyStmt, 1, source.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(historyStmt, 2, e.customerId);
+        sqlite3_bind_int(historyStmt, 3, e.encounters);
+        sqlite3_bind_double(historyStmt, 4, (double)e.secondsNear);
+        sqlite3_bind_text(historyStmt, 5, e.seen.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_double(historyStmt, 6, (double)e.closestGap);
+        sqlite3_bind_int(historyStmt, 7, e.closestLap);
+        ok = ok && sqlite3_step(historyStmt) == SQLITE_DONE;
+        sqlite3_reset(historyStmt);
+    }
+
+    db.Finalize(repStmt);
+    db.Finalize(historyStmt);
+    db.Finalize(windowStmt);
+
+    if (!ok)
+    {
+        Logger::Error("SQLite error importando encuentros de " + source);
+        db.Rollback();
+        return false;
+    }
+    return db.Commit();
+}
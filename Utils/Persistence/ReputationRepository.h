@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <map>
+#include <vector>
 #include "../../Utils/Common/Types.h"
 #include "Database.h"
 
@@ -11,6 +12,19 @@ public:
     bool LoadAll(Database &db, std::map<int, DriverReputation> &out);
     bool Upsert(Database &db, const DriverReputation &rep);
 
+    // Importación de sesiones: source identifica la grabación (hash del .ibt, o un seguimiento
+    // en vivo), no el nombre del archivo
+    bool IsSessionImported(Database &db, const std::string &source);
+    // Tramos guardados en vivo de una SubSessionID y jugador; el .ibt de esa sesión no los vuelve
+    // a contar. Vacío sin SubSessionID
+    bool LoadLiveWindows(Database &db, int subSessionId, int customerId, std::vector<SessionWindow> &out);
+    // Suma los encuentros a driver_reputation y a proximity_history y guarda los tramos de sesión
+    // en session_windows, en una transacción. Lo usan la importación de .ibt (un lote por archivo)
+    // y EncounterTracker (varios lotes por sesión)
+    bool MergeSessionEncounters(Database &db, const std::string &source, const std::vector<SessionWindow> &windows,
+                                const std::vector<EncounterSummary> &encounters);
+
 private:
     bool EnsureSchema(Database &db);
+    bool HasColumn(Database &db, const char *table, const char *column);
 };
@@ -0,0 +1,714 @@
+/*
+MIT License - iRacing Reputation System
+Punto de entrada de benchmarks (iRacingReputationBench)
+
+Uso:
+    iRacingReputationBench yaml <session.yaml> [<session.yaml> ...] [--iterations N]
+    iRacingReputationBench live [--seconds N] [--hgrm salida.hgrm]
+    iRacingReputationBench replay <archivo.ibt> [--speed N|max] [--from S] [--capture salida.ircap] [--hgrm salida.hgrm]
+    iRacingReputationBench columns <archivo.ibt> [--iterations N]
+    iRacingReputationBench gaps <archivo.ibt> [--iterations N]
+    iRacingReputationBench capture <archivo.ircap> [--export salida.ibt]
+    iRacingReputationBench ring <archivo.ibt> [--speed N|max] [--consumer-us N]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Utils/Logging/Logger.h"
+#include "Utils/IRacing/YAMLDriverParser.h"
+#include "Core/IRacingSDK/IRacingConnection.h"
+#include "Core/IRacingSDK/irsdk_platform.h"
+#include "Core/IRacingSDK/ReplayTelemetrySource.h"
+#include "Core/IRacingSDK/TelemetryReader.h"
+#include "Core/IRacingSDK/irsdk_diskclient.h"
+#include "Core/IRacingSDK/SessionInfoCache.h"
+#include "Core/ProximityDetector/GapEngine.h"
+#include "Core/Analysis/IbtColumnExtractor.h"
+#include "Core/Capture/CaptureReader.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    bool ReadWholeFile(const char *path, std::string &out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        std::stringstream ss;
+        ss << file.rdbuf();
+        out = ss.str();
+        return true;
+    }
+
+    int ParseIterations(int argc, char **argv, int fallback)
+    {
+        for (int i = 0; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--iterations") == 0)
+                return std::max(1, atoi(argv[i + 1]));
+        }
+        return fallback;
+    }
+
+    bool SameDrivers(const std::vector<DriverData> &a, const std::vector<DriverData> &b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            const DriverData &x = a[i];
+            const DriverData &y = b[i];
+            if (x.carIdx != y.carIdx || x.customerId != y.customerId || x.userName != y.userName ||
+                x.displayName != y.displayName || x.carNumber != y.carNumber || x.iRating != y.iRating ||
+                x.licenseString != y.licenseString || x.licenseLevel != y.licenseLevel ||
+                x.safetyRating != y.safetyRating || x.isPlayer != y.isPlayer)
+                return false;
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    double TimeMs(int iterations, Fn &&fn)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Compara el indexador de una pasada con la ruta anterior de parseYaml por campo
+    int BenchYaml(int argc, char **argv)
+    {
+        const int iterations = ParseIterations(argc, argv, 200);
+        int failures = 0;
+
+        printf("%-40s %8s %8s %12s %12s %8s\n", "file", "bytes", "drivers", "legacy ms", "indexed ms", "speedup");
+        for (int i = 0; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--iterations") == 0)
+            {
+                i++;
+                continue;
+            }
+
+            std::string yaml;
+            if (!ReadWholeFile(argv[i], yaml))
+            {
+                printf("%-40s no se pudo leer\n", argv[i]);
+                failures++;
+                continue;
+            }
+
+            auto legacy = YAMLDriverParser::ParseDriverInfoFromYAMLLegacy(yaml, -1);
+            auto indexed = YAMLDriverParser::ParseDriverInfoFromYAML(yaml, -1);
+            if (!SameDrivers(legacy, indexed))
+            {
+                printf("%-40s RESULTADOS DISTINTOS (legacy=%d, indexed=%d)\n", argv[i],
+                       (int)legacy.size(), (int)indexed.size());
+                failures++;
+                continue;
+            }
+
+            double legacyMs = TimeMs(iterations, [&]
+                                     { legacy = YAMLDriverParser::ParseDriverInfoFromYAMLLegacy(yaml, -1); });
+            double indexedMs = TimeMs(iterations, [&]
+                                      { indexed = YAMLDriverParser::ParseDriverInfoFromYAML(yaml, -1); });
+
+            printf("%-40s %8d %8d %12.3f %12.3f %7.1fx\n", argv[i], (int)yaml.size(), (int)indexed.size(),
+                   legacyMs / iterations, indexedMs / iterations, indexedMs > 0.0 ? legacyMs / indexedMs : 0.0);
+        }
+
+        return failures == 0 ? 0 : 1;
+    }
+
+    double ParseSeconds(int argc, char **argv, double fallback)
+    {
+        for (int i = 0; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--seconds") == 0)
+                return std::max(0.1, atof(argv[i + 1]));
+        }
+        return fallback;
+    }
+
+    double Percentile(std::vector<double> &sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+        return sorted[idx];
+    }
+
+    const char *ParseHgrmPath(int argc, char **argv)
+    {
+        for (int i = 0; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--hgrm") == 0)
+                return argv[i + 1];
+        }
+        return nullptr;
+    }
+
+    // Resumen de la instrumentación de IRacingConnection y, si se pide, volcado .hgrm
+    void PrintAcquisition(const AcquisitionStats &stats, const char *hgrmPath)
+    {
+        printf("adquisición: %llu ticks, %llu perdidos por lectura lenta, %llu filas rotas\n",
+               (unsigned long long)stats.ticks, (unsigned long long)stats.droppedTicks,
+               (unsigned long long)stats.tornReads);
+
+        auto row = [](const char *name, const HdrHistogram &histogram, double unitScale, const char *unit)
+        {
+            printf("  %-9s n %7llu  p50 %9.2f  p99 %9.2f  p99.9 %9.2f  max %9.2f %s\n", name,
+                   (unsigned long long)histogram.GetCount(), histogram.ValueAtPercentile(50.0) / unitScale,
+                   histogram.ValueAtPercentile(99.0) / unitScale, histogram.ValueAtPercentile(99.9) / unitScale,
+                   histogram.GetMax() / unitScale, unit);
+        };
+        row("tickGap", stats.tickGap, 1.0, "ticks");
+        row("retries", stats.retries, 1.0, "");
+        row("copia", stats.copyNs, 1000.0, "us");
+        row("latencia", stats.latencyNs, 1000.0, "us");
+
+        if (hgrmPath && stats.WriteToFile(hgrmPath))
+            printf("histogramas guardados en %s\n", hgrmPath);
+    }
+
+    // Lee la telemetría en vivo (simulador o iRacingTelemetryProducer) con IRacingConnection
+    // y mide latencia señal -> consumo, ticks perdidos a partir de SessionTick y los
+    // despertares por minuto en cada estado de la conexión
+    int BenchLive(int argc, char **argv)
+    {
+        const double seconds = ParseSeconds(argc, argv, 10.0);
+
+        IRacingConnection connection;
+        connection.Initialize();
+
+        std::vector<double> latencyUs;
+        std::vector<double> updateUs;
+        int ticks = 0;
+        int dropped = 0;
+        int lastSessionTick = -1;
+
+        const auto start = Clock::now();
+        while (std::chrono::duration<double>(Clock::now() - start).count() < seconds)
+        {
+            auto before = Clock::now();
+            connection.Update();
+            if (!connection.ReceivedNewTick())
+                continue;
+
+            const long long signalNs = irsdkPlatform_lastSignalNs();
+            if (signalNs > 0)
+                latencyUs.push_back((irsdkPlatform_nowNs() - signalNs) / 1000.0);
+            updateUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+
+            int sessionTick = connection.GetVars().Value(TelemetryVars::SessionTick, -1);
+            if (lastSessionTick >= 0 && sessionTick > lastSessionTick + 1)
+                dropped += sessionTick - lastSessionTick - 1;
+            lastSessionTick = sessionTick;
+            ticks++;
+        }
+
+        const irsdk_header *header = irsdk_getHeader();
+        printf("ticks leídos: %d en %.1f s (%.1f Hz, tickRate %d), perdidos: %d\n", ticks, seconds,
+               ticks / seconds, header ? header->tickRate : 0, dropped);
+        printf("bytes copiados por tick: %d de %d\n", irsdk_getCopyBytes(), header ? header->bufLen : 0);
+
+        std::sort(updateUs.begin(), updateUs.end());
+        printf("Update() con tick (incluye la espera) us:  p50 %8.1f  p99 %8.1f  max %8.1f\n", Percentile(updateUs, 0.5),
+               Percentile(updateUs, 0.99), updateUs.empty() ? 0.0 : updateUs.back());
+
+        if (latencyUs.empty())
+        {
+            printf("latencia señal -> consumo: n/d en esta plataforma\n");
+        }
+        else
+        {
+            std::sort(latencyUs.begin(), latencyUs.end());
+            printf("latencia señal -> consumo us:  p50 %8.1f  p99 %8.1f  max %8.1f\n", Percentile(latencyUs, 0.5),
+                   Percentile(latencyUs, 0.99), latencyUs.back());
+        }
+
+        PrintAcquisition(connection.GetAcquisitionStats(), ParseHgrmPath(argc, argv));
+
+        // Coste de cada estado de la conexión (sin simulador debería ser casi cero)
+        for (int i = 0; i < ConnectionStateMachine::STATE_COUNT; ++i)
+        {
+            const auto state = static_cast<ConnectionStatus>(i);
+            const auto stats = connection.GetStateMachine().GetStats(state);
+            printf("estado %-12s %7.2f s  %8llu despertares  %10.1f/min\n", ConnectionStateMachine::GetStateName(state),
+                   stats.seconds, (unsigned long long)stats.wakeups, stats.WakeupsPerMinute());
+        }
+
+        connection.Shutdown();
+        return ticks > 0 ? 0 : 1;
+    }
+
+    // Reproduce un .ibt a través de IRacingConnection (la misma ruta que la telemetría en vivo)
+    // y mide ticks/s del pipeline completo más un barrido de proximidad por frame
+    int BenchReplay(int argc, char **argv)
+    {
+        double speed = ReplayTelemetrySource::AS_FAST_AS_POSSIBLE;
+        double from = -1.0;
+        const char *capturePath = nullptr;
+        for (int i = 1; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--capture") == 0)
+                capturePath = argv[i + 1];
+            if (strcmp(argv[i], "--speed") == 0)
+                speed = strcmp(argv[i + 1], "max") == 0 ? ReplayTelemetrySource::AS_FAST_AS_POSSIBLE : atof(argv[i + 1]);
+            if (strcmp(argv[i], "--from") == 0)
+                from = atof(argv[i + 1]);
+        }
+
+        auto source = std::make_unique<ReplayTelemetrySource>(argv[0], speed);
+        ReplayTelemetrySource *replay = source.get();
+        if (!replay->Open())
+        {
+            printf("%s: no se pudo abrir\n", argv[0]);
+            return 1;
+        }
+
+        if (from >= 0.0)
+        {
+            const auto seekStart = Clock::now();
+            const bool found = replay->SeekToTime(from);
+            printf("salto a SessionTime %.1f: %s en %.1f us\n", from, found ? "ok" : "sin SessionTime",
+                   std::chrono::duration<double, std::micro>(Clock::now() - seekStart).count());
+        }
+
+        IRacingConnection connection(std::move(source));
+        connection.Initialize();
+        if (capturePath)
+            connection.StartCapture(capturePath);
+
+        const float proximitySeconds = 2.0f;
+        int ticks = 0;
+        long long nearbyTotal = 0;
+        std::vector<double> updateUs;
+        updateUs.reserve(replay->GetRowCount());
+
+        const auto start = Clock::now();
+        while (!replay->IsFinished())
+        {
+            auto before = Clock::now();
+            connection.Update();
+            if (!connection.ReceivedNewTick())
+                continue;
+            updateUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+
+            const CarTelemetryFrame &frame = connection.GetTelemetryFrame();
+            for (int i = 0; i < CarTelemetryFrame::MAX_CARS; ++i)
+                nearbyTotal += frame.HasGap(i) && std::abs(frame.gapToPlayer[i]) <= proximitySeconds;
+            ticks++;
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        printf("%s: %d de %d registros en %.3f s (%.0f ticks/s, velocidad %s)\n", argv[0], ticks,
+               replay->GetRowCount(), seconds, ticks / std::max(seconds, 1e-9),
+               speed > 0.0 ? std::to_string(speed).c_str() : "max");
+        printf("bytes copiados por tick: %d de %d\n", replay->GetCopyBytes(), replay->GetBufLen());
+        printf("coches a menos de %.1f s por tick: %.2f de media\n", proximitySeconds,
+               ticks > 0 ? (double)nearbyTotal / ticks : 0.0);
+
+        std::sort(updateUs.begin(), updateUs.end());
+        printf("Update() us:  p50 %8.2f  p99 %8.2f  max %8.2f\n", Percentile(updateUs, 0.5),
+               Percentile(updateUs, 0.99), updateUs.empty() ? 0.0 : updateUs.back());
+        PrintAcquisition(connection.GetAcquisitionStats(), ParseHgrmPath(argc, argv));
+
+        connection.Shutdown();
+        return ticks > 0 ? 0 : 1;
+    }
+
+    // Compara leer los CarIdx* de un .ibt con irsdkDiskClient (getVarFloat por elemento)
+    // contra la extracción columnar de una pasada. Ambas suman lo mismo como comprobación.
+    int BenchColumns(int argc, char **argv)
+    {
+        const int iterations = ParseIterations(argc, argv, 5);
+        const char *path = argv[0];
+        const char *names[] = {"SessionTime", "CarIdxLap", "CarIdxLapDistPct", "CarIdxEstTime"};
+
+        double legacySum = 0.0;
+        int legacyRecords = 0;
+        double legacyMs = TimeMs(iterations, [&]()
+                                 {
+            irsdkDiskClient file(path);
+            int idx[4];
+            for (int v = 0; v < 4; ++v)
+                idx[v] = file.getVarIdx(names[v]);
+
+            legacySum = 0.0;
+            legacyRecords = 0;
+            while (file.getNextData())
+            {
+                for (int v = 0; v < 4; ++v)
+                {
+                    for (int e = 0; e < file.getVarCount(idx[v]); ++e)
+                        legacySum += file.getVarDouble(idx[v], e);
+                }
+                legacyRecords++;
+            } });
+
+        double columnSum = 0.0;
+        int columnRecords = 0;
+        IbtColumnExtractor extractor({names[0], names[1], names[2], names[3]});
+        double columnMs = TimeMs(iterations, [&]()
+                                 {
+            extractor.Extract(path);
+            columnRecords = extractor.GetRecordCount();
+            columnSum = 0.0;
+            for (const auto &column : extractor.GetColumns())
+            {
+                const size_t n = static_cast<size_t>(column.GetCount()) * column.GetRecordCount();
+                if (const double *d = column.Values<double>())
+                    for (size_t i = 0; i < n; ++i)
+                        columnSum += d[i];
+                if (const float *f = column.Values<float>())
+                    for (size_t i = 0; i < n; ++i)
+                        columnSum += f[i];
+                if (const int *v = column.Values<int>())
+                    for (size_t i = 0; i < n; ++i)
+                        columnSum += v[i];
+            } });
+
+        const bool same = legacyRecords == columnRecords && std::abs(legacySum - columnSum) <= 1e-6 * std::abs(legacySum) + 1e-6;
+        printf("%s: %d registros, %d columnas%s\n", path, columnRecords, (int)extractor.GetColumns().size(),
+               same ? "" : "  RESULTADOS DISTINTOS");
+        printf("irsdkDiskClient  %10.3f ms/archivo\n", legacyMs / iterations);
+        printf("columnar         %10.3f ms/archivo  %7.1fx\n", columnMs / iterations, legacyMs / std::max(columnMs, 1e-9));
+        return same ? 0 : 1;
+    }
+
+    // Mide GapEngine::Compute() (con el filtro de pit road y superficie) contra el mismo
+    // bucle sin filtro sobre todos los registros de un .ibt, y comprueba que el filtro sólo
+    // descarta coches: donde ambos dan gap válido, los resultados coinciden
+    int BenchGaps(int argc, char **argv)
+    {
+        const int iterations = ParseIterations(argc, argv, 20);
+        const char *path = argv[0];
+
+        IbtColumnExtractor extractor({"CarIdxLap", "CarIdxLapDistPct", "CarIdxEstTime", "CarIdxOnPitRoad", "CarIdxTrackSurface"});
+        if (!extractor.Extract(path))
+        {
+            printf("%s: no se pudo leer\n", path);
+            return 1;
+        }
+
+        const IbtColumn *lapCol = extractor.Find("CarIdxLap");
+        const IbtColumn *pctCol = extractor.Find("CarIdxLapDistPct");
+        const IbtColumn *estCol = extractor.Find("CarIdxEstTime");
+        const IbtColumn *pitCol = extractor.Find("CarIdxOnPitRoad");
+        const IbtColumn *surfaceCol = extractor.Find("CarIdxTrackSurface");
+        if (!lapCol || !pctCol || !estCol || !lapCol->Values<int>() || !pctCol->Values<float>() || !estCol->Values<float>())
+        {
+            printf("%s: faltan las variables CarIdx* necesarias\n", path);
+            return 1;
+        }
+        if (pitCol && !pitCol->Values<bool>())
+            pitCol = nullptr;
+        if (surfaceCol && !surfaceCol->Values<int>())
+            surfaceCol = nullptr;
+
+        SessionInfoCache session;
+        session.Refresh(1, extractor.GetSessionInfo().c_str(), -1);
+        const int playerCarIdx = session.Get().driverCarIdx;
+        const float trackLength = session.Get().weekend.trackLengthMeters;
+        const int cars = std::min(pctCol->GetCount(), static_cast<int>(CarTelemetryFrame::MAX_CARS));
+        const int records = extractor.GetRecordCount();
+
+        // Un frame por registro, rellenado antes de medir: sólo se cronometra el kernel
+        std::vector<CarTelemetryFrame> frames(records);
+        for (int r = 0; r < records; ++r)
+        {
+            std::copy_n(lapCol->Record<int>(r), cars, frames[r].lap);
+            std::copy_n(pctCol->Record<float>(r), cars, frames[r].lapDistPct);
+            std::copy_n(estCol->Record<float>(r), cars, frames[r].estTime);
+            if (pitCol && pitCol->GetCount() >= cars)
+                std::copy_n(pitCol->Record<bool>(r), cars, frames[r].onPitRoad);
+            if (surfaceCol && surfaceCol->GetCount() >= cars)
+                std::copy_n(surfaceCol->Record<int>(r), cars, frames[r].trackSurface);
+        }
+
+        // Comprobación y recuento de coches descartados
+        long long validUnfiltered = 0;
+        long long validFiltered = 0;
+        int mismatches = 0;
+        CarTelemetryFrame unfiltered;
+        for (int r = 0; r < records; ++r)
+        {
+            unfiltered = frames[r];
+            GapEngine::ComputeUnfiltered(unfiltered, playerCarIdx, trackLength);
+            GapEngine::Compute(frames[r], playerCarIdx, trackLength);
+            for (int i = 0; i < CarTelemetryFrame::MAX_CARS; ++i)
+            {
+                validUnfiltered += unfiltered.gapValid[i];
+                validFiltered += frames[r].gapValid[i];
+                if (frames[r].gapValid[i] && (!unfiltered.gapValid[i] || frames[r].gapToPlayer[i] != unfiltered.gapToPlayer[i] ||
+                                              frames[r].distanceToPlayer[i] != unfiltered.distanceToPlayer[i]))
+                    mismatches++;
+            }
+        }
+
+        // Alternando las dos variantes para que ninguna se beneficie del orden
+        double unfilteredMs = 0.0;
+        double filteredMs = 0.0;
+        for (int it = 0; it < iterations; ++it)
+        {
+            unfilteredMs += TimeMs(1, [&]()
+                                   {
+                for (auto &frame : frames)
+                    GapEngine::ComputeUnfiltered(frame, playerCarIdx, trackLength); });
+            filteredMs += TimeMs(1, [&]()
+                                 {
+                for (auto &frame : frames)
+                    GapEngine::Compute(frame, playerCarIdx, trackLength); });
+        }
+
+        const double calls = static_cast<double>(records) * iterations;
+        printf("%s: %d registros, jugador %d, pit road %s, superficie %s%s\n", path, records, playerCarIdx,
+               pitCol ? "sí" : "no", surfaceCol ? "sí" : "no", mismatches == 0 ? "" : "  RESULTADOS DISTINTOS");
+        printf("coches con gap: %.2f/registro sin filtro, %.2f con filtro (%lld descartados)\n",
+               validUnfiltered / std::max(1.0, static_cast<double>(records)),
+               validFiltered / std::max(1.0, static_cast<double>(records)), validUnfiltered - validFiltered);
+        printf("sin filtro  %8.1f ns/registro\n", unfilteredMs * 1e6 / std::max(calls, 1.0));
+        printf("con filtro  %8.1f ns/registro  %+6.1f %%\n", filteredMs * 1e6 / std::max(calls, 1.0),
+               unfilteredMs > 0.0 ? (filteredMs / unfilteredMs - 1.0) * 100.0 : 0.0);
+        return mismatches == 0 ? 0 : 1;
+    }
+
+    // Decodifica una captura .ircap entera, mide saltos por el índice de keyframes y,
+    // con --export, la vuelca a .ibt y comprueba fila a fila que irsdkDiskClient lee lo mismo
+    int BenchCapture(int argc, char **argv)
+    {
+        const char *exportPath = nullptr;
+        for (int i = 1; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--export") == 0)
+                exportPath = argv[i + 1];
+        }
+
+        CaptureReader reader;
+        if (!reader.Open(argv[0]))
+        {
+            printf("%s: no se pudo abrir\n", argv[0]);
+            return 1;
+        }
+
+        std::ifstream file(argv[0], std::ios::binary | std::ios::ate);
+        const long long fileBytes = static_cast<long long>(file.tellg());
+        const long long rawBytes = static_cast<long long>(reader.GetTickCount()) * reader.GetBufLen();
+
+        int ticks = 0;
+        const auto start = Clock::now();
+        while (reader.Next())
+            ticks++;
+        const double decodeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        printf("%s: %d de %d ticks, %d variables, %d bytes por fila\n", argv[0], ticks, reader.GetTickCount(),
+               reader.GetNumVars(), reader.GetBufLen());
+        printf("tamaño: %lld bytes (%.1f%% de %lld en filas completas), %.2f bytes/tick\n", fileBytes,
+               rawBytes > 0 ? 100.0 * fileBytes / rawBytes : 0.0, rawBytes, ticks > 0 ? (double)fileBytes / ticks : 0.0);
+        printf("decodificación: %.3f ms (%.0f ticks/s)\n", decodeMs, ticks / std::max(decodeMs / 1000.0, 1e-9));
+
+        if (reader.GetTickCount() > 0)
+        {
+            const int target = reader.GetTickCount() * 3 / 4;
+            const auto seekStart = Clock::now();
+            const bool ok = reader.Seek(target) && reader.Next() && reader.GetTickIndex() == target;
+            printf("salto al tick %d: %s en %.1f us\n", target, ok ? "ok" : "ERROR",
+                   std::chrono::duration<double, std::micro>(Clock::now() - seekStart).count());
+            if (!ok)
+                return 1;
+        }
+
+        if (!exportPath)
+            return ticks == reader.GetTickCount() ? 0 : 1;
+
+        if (!reader.ExportIbt(exportPath))
+        {
+            printf("exportación a %s fallida\n", exportPath);
+            return 1;
+        }
+
+        irsdkDiskClient ibt(exportPath);
+        int matching = 0;
+        reader.Seek(0);
+        while (reader.Next() && ibt.getNextData())
+        {
+            if (memcmp(ibt.getData(), reader.GetRow(), reader.GetBufLen()) == 0)
+                matching++;
+        }
+        const bool sameSession = ibt.getSessionStr() && reader.GetSessionInfo() == ibt.getSessionStr();
+        printf("exportado a %s: %d/%d filas idénticas, YAML %s\n", exportPath, matching, reader.GetTickCount(),
+               sameSession ? "idéntico" : "DISTINTO");
+        return matching == reader.GetTickCount() && sameSession ? 0 : 1;
+    }
+
+    // Reproduce un .ibt con TelemetryReader y lee el anillo de frames con tres consumidores a
+    // distinto ritmo: en orden sin pausa, en orden con consumerUs por frame y sólo el último
+    // tick cada 16 ms (como la UI). Los consumidores en orden deben sumar leídos + perdidos = escritos.
+    int BenchRing(int argc, char **argv)
+    {
+        double speed = ReplayTelemetrySource::AS_FAST_AS_POSSIBLE;
+        int consumerUs = 200;
+        for (int i = 1; i < argc - 1; ++i)
+        {
+            if (strcmp(argv[i], "--speed") == 0)
+                speed = strcmp(argv[i + 1], "max") == 0 ? ReplayTelemetrySource::AS_FAST_AS_POSSIBLE : atof(argv[i + 1]);
+            if (strcmp(argv[i], "--consumer-us") == 0)
+                consumerUs = std::max(0, atoi(argv[i + 1]));
+        }
+
+        auto source = std::make_unique<ReplayTelemetrySource>(argv[0], speed);
+        if (!source->Open())
+        {
+            printf("%s: no se pudo abrir\n", argv[0]);
+            return 1;
+        }
+        const uint64_t rows = static_cast<uint64_t>(source->GetRowCount());
+
+        auto reader = std::make_unique<TelemetryReader>(std::move(source));
+        const TelemetryFrameRing &ring = reader->GetFrameRing();
+
+        struct Consumer
+        {
+            const char *name;
+            bool inOrder;
+            std::chrono::microseconds pause;
+            TelemetryFrameRing::Cursor cursor;
+            uint64_t outOfOrder = 0; // Secuencias que no cuadran con leídos + perdidos
+        };
+        Consumer consumers[] = {
+            {"en orden", true, std::chrono::microseconds(0), ring.Subscribe()},
+            {"en orden lento", true, std::chrono::microseconds(consumerUs), ring.Subscribe()},
+            {"último (UI)", false, std::chrono::milliseconds(16), ring.Subscribe()},
+        };
+
+        std::atomic<bool> producing{true};
+        std::vector<std::thread> threads;
+        for (auto &consumer : consumers)
+        {
+            threads.emplace_back([&ring, &producing, &consumer]()
+                                 {
+                TelemetryTick tick;
+                while (true)
+                {
+                    const bool done = !producing;
+                    const bool got = consumer.inOrder ? ring.Read(consumer.cursor, tick) : ring.ReadLatest(consumer.cursor, tick);
+                    if (!got)
+                    {
+                        if (done)
+                            return;
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    if (consumer.inOrder && tick.sequence != consumer.cursor.reads + consumer.cursor.overruns)
+                        consumer.outOfOrder++;
+                    if (consumer.pause.count() > 0)
+                        std::this_thread::sleep_for(consumer.pause);
+                } });
+        }
+
+        const auto start = Clock::now();
+        reader->Start();
+        std::shared_ptr<const TelemetrySnapshot> midSession; // Estado de sesión a mitad de reproducción
+        while (ring.GetWriteCount() < rows)
+        {
+            if (!midSession && ring.GetWriteCount() >= rows / 2)
+                midSession = reader->GetSnapshot();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        reader->Stop();
+
+        producing = false;
+        for (auto &thread : threads)
+            thread.join();
+
+        const uint64_t written = ring.GetWriteCount();
+        printf("%s: %llu ticks escritos en %.3f s (%.0f ticks/s), anillo de %d frames de %zu bytes\n", argv[0],
+               (unsigned long long)written, seconds, written / std::max(seconds, 1e-9), TelemetryFrameRing::CAPACITY,
+               sizeof(TelemetryTick));
+
+        if (midSession)
+            printf("estado de sesión a mitad: publicación %llu, roster v%llu con %d pilotos\n",
+                   (unsigned long long)midSession->sequence, (unsigned long long)midSession->roster->version,
+                   (int)midSession->roster->drivers.size());
+
+        bool consistent = true;
+        for (const auto &consumer : consumers)
+        {
+            printf("  %-16s leídos %8llu  perdidos %8llu", consumer.name, (unsigned long long)consumer.cursor.reads,
+                   (unsigned long long)consumer.cursor.overruns);
+            if (consumer.inOrder)
+            {
+                const bool ok = consumer.cursor.reads + consumer.cursor.overruns == written && consumer.outOfOrder == 0;
+                consistent = consistent && ok;
+                printf("  %s", ok ? "ok" : "INCONSISTENTE");
+            }
+            printf("\n");
+        }
+        return written == rows && consistent ? 0 : 1;
+    }
+
+    void PrintUsage()
+    {
+        printf("Uso:\n");
+        printf("  iRacingReputationBench yaml <session.yaml> [...] [--iterations N]\n");
+        printf("  iRacingReputationBench live [--seconds N] [--hgrm salida.hgrm]\n");
+        printf("  iRacingReputationBench replay <archivo.ibt> [--speed N|max] [--from S] [--capture salida.ircap] [--hgrm salida.hgrm]\n");
+        printf("  iRacingReputationBench columns <archivo.ibt> [--iterations N]\n");
+        printf("  iRacingReputationBench gaps <archivo.ibt> [--iterations N]\n");
+        printf("  iRacingReputationBench capture <archivo.ircap> [--export salida.ibt]\n");
+        printf("  iRacingReputationBench ring <archivo.ibt> [--speed N|max] [--consumer-us N]\n");
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    // Los parsers registran cada llamada; en el benchmark sólo interesan los avisos
+    Logger::SetLevel(LOG_WARNING);
+
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (strcmp(argv[1], "yaml") == 0 && argc >= 3)
+        return BenchYaml(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "live") == 0)
+        return BenchLive(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "replay") == 0 && argc >= 3)
+        return BenchReplay(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "columns") == 0 && argc >= 3)
+        return BenchColumns(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "gaps") == 0 && argc >= 3)
+        return BenchGaps(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "capture") == 0 && argc >= 3)
+        return BenchCapture(argc - 2, argv + 2);
+
+    if (strcmp(argv[1], "ring") == 0 && argc >= 3)
+        return BenchRing(argc - 2, argv + 2);
+
+    PrintUsage();
+    return 1;
+}
@@ -12,6 +12,69 @@ if "%1"=="clean" (
     goto :end
 )
 
+if "%1"=="bench" (
+    echo Compilando benchmarks en modo Release...
+    cl.exe /std:c++17 /utf-8 /EHsc /O2 /MD /DNDEBUG /D_CONSOLE /D_CRT_SECURE_NO_WARNINGS ^
+    /I. /I./Core/IRacingSDK /I./External/ImGui ^
+    bench_main.cpp ^
+    Utils/Logging/Logger.cpp ^
+    Utils/IRacing/StringUtils.cpp ^
+    Utils/IRacing/YAMLDriverParser.cpp ^
+    Utils/IRacing/YAMLDriverIndexer.cpp ^
+    Core/IRacingSDK/irsdk_client.cpp ^
+    Core/IRacingSDK/irsdk_utils.cpp ^
+    Core/IRacingSDK/irsdk_platform_win32.cpp ^
+    Core/IRacingSDK/yaml_parser.cpp ^
+    Core/IRacingSDK/IRacingVariables.cpp ^
+    Core/IRacingSDK/IRacingConnection.cpp ^
+    Core/IRacingSDK/ConnectionStateMachine.cpp ^
+    Core/IRacingSDK/AcquisitionStats.cpp ^
+    Core/IRacingSDK/TelemetryReader.cpp ^
+    Core/Capture/CaptureWriter.cpp ^
+    Core/Capture/CaptureReader.cpp ^
+    Core/IRacingSDK/LiveTelemetrySource.cpp ^
+    Core/IRacingSDK/ReplayTelemetrySource.cpp ^
+    Core/IRacingSDK/IbtMappedFile.cpp ^
+    Core/IRacingSDK/irsdk_diskclient.cpp ^
+    Core/Analysis/IbtColumnExtractor.cpp ^
+    Core/IRacingSDK/SessionInfoCache.cpp ^
+    Core/IRacingSDK/TelemetryVarRegistry.cpp ^
+    Core/ProximityDetector/GapEngine.cpp ^
+    Core/ProximityDetector/ClosingRateEstimator.cpp ^
+    Utils/IRacing/SessionInfoProvider.cpp ^
+    /Fe:iRacingReputationBench.exe ^
+    /link user32.lib
+    goto :result
+)
+
+if "%1"=="batch" (
+    echo Compilando analizador por lotes...
+    cl.exe /std:c++17 /utf-8 /EHsc /O2 /MD /DNDEBUG /D_CONSOLE /D_CRT_SECURE_NO_WARNINGS ^
+    /I. /I./Core/IRacingSDK /I./External/ImGui /I./External/SQLite /I./Utils/Persistence ^
+    batch_main.cpp ^
+    Utils/Logging/Logger.cpp ^
+    Utils/IRacing/StringUtils.cpp ^
+    Utils/IRacing/YAMLDriverParser.cpp ^
+    Utils/IRacing/YAMLDriverIndexer.cpp ^
+    Utils/IRacing/SessionInfoProvider.cpp ^
+    Utils/Persistence/Database.cpp ^
+    Utils/Persistence/ReputationRepository.cpp ^
+    Core/IRacingSDK/irsdk_client.cpp ^
+    Core/IRacingSDK/irsdk_utils.cpp ^
+    Core/IRacingSDK/irsdk_platform_win32.cpp ^
+    Core/IRacingSDK/yaml_parser.cpp ^
+    Core/IRacingSDK/IRacingVariables.cpp ^
+    Core/IRacingSDK/SessionInfoCache.cpp ^
+    Core/IRacingSDK/IbtMappedFile.cpp ^
+    Core/Analysis/IbtColumnExtractor.cpp ^
+    Core/Analysis/EncounterAnalyzer.cpp ^
+    Core/ProximityDetector/GapEngine.cpp ^
+    External/SQLite/sqlite3.c ^
+    /Fe:iRacingReputationBatch.exe ^
+    /link user32.lib
+    goto :result
+)
+
 if "%1"=="release" (
     echo Compilando en modo Release...
     cl.exe /std:c++17 /utf-8 /EHsc /O2 /MD /DNDEBUG /D_CONSOLE /D_CRT_SECURE_NO_WARNINGS ^
@@ -22,6 +85,7 @@ if "%1"=="release" (
     Utils/Graphics/IconManager.cpp ^
     Utils/IRacing/StringUtils.cpp ^
     Utils/IRacing/YAMLDriverParser.cpp ^
+    Utils/IRacing/YAMLDriverIndexer.cpp ^
     Utils/IRacing/SessionInfoProvider.cpp ^
     UI/DriverTagWindow.cpp ^
     UI/DriverTagWindow_Init.cpp ^
@@ -37,11 +101,25 @@ if "%1"=="release" (
     UI/Components/SideMenu.cpp ^
     Core/IRacingSDK/irsdk_client.cpp ^
     Core/IRacingSDK/irsdk_utils.cpp ^
+    Core/IRacingSDK/irsdk_platform_win32.cpp ^
     Core/IRacingSDK/yaml_parser.cpp ^
     Overlay/OverlayProximityTags.cpp ^
     Core/Application/ProximityLogic.cpp ^
+    Core/Analysis/EncounterTracker.cpp ^
     Core/IRacingSDK/IRacingVariables.cpp ^
     Core/IRacingSDK/IRacingConnection.cpp ^
+    Core/IRacingSDK/ConnectionStateMachine.cpp ^
+    Core/IRacingSDK/AcquisitionStats.cpp ^
+    Core/Capture/CaptureWriter.cpp ^
+    Core/IRacingSDK/LiveTelemetrySource.cpp ^
+    Core/IRacingSDK/ReplayTelemetrySource.cpp ^
+    Core/IRacingSDK/IbtMappedFile.cpp ^
+    Core/Analysis/IbtColumnExtractor.cpp ^
+    Core/IRacingSDK/SessionInfoCache.cpp ^
+    Core/IRacingSDK/TelemetryReader.cpp ^
+    Core/IRacingSDK/TelemetryVarRegistry.cpp ^
+    Core/ProximityDetector/GapEngine.cpp ^
+    Core/ProximityDetector/ClosingRateEstimator.cpp ^
     Utils/Persistence/Database.cpp ^
     Utils/Persistence/ReputationRepository.cpp ^
     External/SQLite/sqlite3.c ^
@@ -63,6 +141,7 @@ if "%1"=="release" (
     Utils/Graphics/IconManager.cpp ^
     Utils/IRacing/StringUtils.cpp ^
     Utils/IRacing/YAMLDriverParser.cpp ^
+    Utils/IRacing/YAMLDriverIndexer.cpp ^
     Utils/IRacing/SessionInfoProvider.cpp ^
     UI/DriverTagWindow.cpp ^
     UI/DriverTagWindow_Init.cpp ^
@@ -78,11 +157,25 @@ if "%1"=="release" (
     UI/Components/SideMenu.cpp ^
     Core/IRacingSDK/irsdk_client.cpp ^
     Core/IRacingSDK/irsdk_utils.cpp ^
+    Core/IRacingSDK/irsdk_platform_win32.cpp ^
     Core/IRacingSDK/yaml_parser.cpp ^
     Overlay/OverlayProximityTags.cpp ^
     Core/Application/ProximityLogic.cpp ^
+    Core/Analysis/EncounterTracker.cpp ^
     Core/IRacingSDK/IRacingVariables.cpp ^
     Core/IRacingSDK/IRacingConnection.cpp ^
+    Core/IRacingSDK/ConnectionStateMachine.cpp ^
+    Core/IRacingSDK/AcquisitionStats.cpp ^
+    Core/Capture/CaptureWriter.cpp ^
+    Core/IRacingSDK/LiveTelemetrySource.cpp ^
+    Core/IRacingSDK/ReplayTelemetrySource.cpp ^
+    Core/IRacingSDK/IbtMappedFile.cpp ^
+    Core/Analysis/IbtColumnExtractor.cpp ^
+    Core/IRacingSDK/SessionInfoCache.cpp ^
+    Core/IRacingSDK/TelemetryReader.cpp ^
+    Core/IRacingSDK/TelemetryVarRegistry.cpp ^
+    Core/ProximityDetector/GapEngine.cpp ^
+    Core/ProximityDetector/ClosingRateEstimator.cpp ^
     Utils/Persistence/Database.cpp ^
     Utils/Persistence/ReputationRepository.cpp ^
     External/SQLite/sqlite3.c ^
@@ -96,6 +189,7 @@ if "%1"=="release" (
     /link d3d11.lib d3dcompiler.lib dxgi.lib user32.lib gdi32.lib
 )
 
+:result
 if %ERRORLEVEL% EQU 0 (
     echo Compilacion exitosa!
     if "%2"=="run" (
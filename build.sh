@@ -0,0 +1,92 @@
+#!/bin/sh
+# iRacing Reputation System - Build Script (Linux/POSIX)
+# Sólo las herramientas de línea de comandos: la aplicación con UI necesita Windows (build.bat).
+#
+#   ./build.sh bench      -> iRacingReputationBench
+#   ./build.sh producer   -> iRacingTelemetryProducer
+#   ./build.sh batch      -> iRacingReputationBatch (usa la libsqlite3 del sistema)
+#   ./build.sh clean
+
+set -e
+cd "$(dirname "$0")"
+
+CXX="${CXX:-g++}"
+CXXFLAGS="-std=c++17 -O2 -DNDEBUG -I. -I./Core/IRacingSDK -I./External/ImGui"
+LIBS="-lpthread -lrt"
+
+case "$1" in
+clean)
+    echo "Limpiando archivos..."
+    rm -f iRacingReputationBench iRacingTelemetryProducer iRacingReputationBatch
+    ;;
+bench)
+    echo "Compilando benchmarks en modo Release..."
+    $CXX $CXXFLAGS \
+        bench_main.cpp \
+        Utils/Logging/Logger.cpp \
+        Utils/IRacing/StringUtils.cpp \
+        Utils/IRacing/YAMLDriverParser.cpp \
+        Utils/IRacing/YAMLDriverIndexer.cpp \
+        Utils/IRacing/SessionInfoProvider.cpp \
+        Core/IRacingSDK/irsdk_client.cpp \
+        Core/IRacingSDK/irsdk_utils.cpp \
+        Core/IRacingSDK/irsdk_platform_posix.cpp \
+        Core/IRacingSDK/yaml_parser.cpp \
+        Core/IRacingSDK/IRacingVariables.cpp \
+        Core/IRacingSDK/IRacingConnection.cpp \
+        Core/IRacingSDK/ConnectionStateMachine.cpp \
+        Core/IRacingSDK/AcquisitionStats.cpp \
+        Core/IRacingSDK/TelemetryReader.cpp \
+        Core/Capture/CaptureWriter.cpp \
+        Core/Capture/CaptureReader.cpp \
+        Core/IRacingSDK/LiveTelemetrySource.cpp \
+        Core/IRacingSDK/ReplayTelemetrySource.cpp \
+        Core/IRacingSDK/IbtMappedFile.cpp \
+        Core/IRacingSDK/irsdk_diskclient.cpp \
+        Core/Analysis/IbtColumnExtractor.cpp \
+        Core/IRacingSDK/SessionInfoCache.cpp \
+        Core/IRacingSDK/TelemetryVarRegistry.cpp \
+        Core/ProximityDetector/GapEngine.cpp \
+        Core/ProximityDetector/ClosingRateEstimator.cpp \
+        -o iRacingReputationBench $LIBS
+    echo "Compilacion exitosa!"
+    ;;
+producer)
+    echo "Compilando productor de telemetría..."
+    $CXX $CXXFLAGS \
+        telemetry_producer_main.cpp \
+        Core/IRacingSDK/irsdk_diskclient.cpp \
+        Core/IRacingSDK/irsdk_platform_posix.cpp \
+        Core/IRacingSDK/yaml_parser.cpp \
+        -o iRacingTelemetryProducer $LIBS
+    echo "Compilacion exitosa!"
+    ;;
+batch)
+    echo "Compilando analizador por lotes..."
+    $CXX $CXXFLAGS \
+        batch_main.cpp \
+        Utils/Logging/Logger.cpp \
+        Utils/IRacing/StringUtils.cpp \
+        Utils/IRacing/YAMLDriverParser.cpp \
+        Utils/IRacing/YAMLDriverIndexer.cpp \
+        Utils/IRacing/SessionInfoProvider.cpp \
+        Utils/Persistence/Database.cpp \
+        Utils/Persistence/ReputationRepository.cpp \
+        Core/IRacingSDK/irsdk_client.cpp \
+        Core/IRacingSDK/irsdk_utils.cpp \
+        Core/IRacingSDK/irsdk_platform_posix.cpp \
+        Core/IRacingSDK/yaml_parser.cpp \
+        Core/IRacingSDK/IRacingVariables.cpp \
+        Core/IRacingSDK/SessionInfoCache.cpp \
+        Core/IRacingSDK/IbtMappedFile.cpp \
+        Core/Analysis/IbtColumnExtractor.cpp \
+        Core/Analysis/EncounterAnalyzer.cpp \
+        Core/ProximityDetector/GapEngine.cpp \
+        -o iRacingReputationBatch -lsqlite3 $LIBS
+    echo "Compilacion exitosa!"
+    ;;
+*)
+    echo "Uso: ./build.sh bench|producer|batch|clean"
+    exit 1
+    ;;
+esac
@@ -24,17 +24,23 @@ SOFTWARE.
 
 #include <iostream>
 #include <exception>
+#include <memory>
+#include <string>
+#include <cstdlib>
 #include <windows.h>
 
 #include "Utils/Logging/Logger.h"
 #include "Core/Application/iRacingReputationApp.h"
+#include "Core/IRacingSDK/ReplayTelemetrySource.h"
 
 /**
  * @brief Punto de entrada principal de la aplicación
  *
- * Inicializa y ejecuta el sistema de reputación de iRacing
+ * Inicializa y ejecuta el sistema de reputación de iRacing.
+ * Con --replay <archivo.ibt> [--speed N|max] lee una carrera grabada en lugar del simulador
+ * y con --capture <archivo.ircap> graba la telemetría en formato compacto.
  */
-int main()
+int main(int argc, char **argv)
 {
     try
     {
@@ -57,7 +63,31 @@ int main()
             SetProcessDPIAware();
         }
 #endif
-        iRacingReputationApp app;
+        std::unique_ptr<ITelemetrySource> source;
+        for (int i = 1; i < argc - 1; ++i)
+        {
+            if (std::string(argv[i]) != "--replay")
+                continue;
+
+            double speed = 1.0;
+            for (int j = 1; j < argc - 1; ++j)
+            {
+                if (std::string(argv[j]) == "--speed")
+                    speed = std::string(argv[j + 1]) == "max" ? ReplayTelemetrySource::AS_FAST_AS_POSSIBLE : atof(argv[j + 1]);
+            }
+
+            auto replay = std::make_unique<ReplayTelemetrySource>(argv[i + 1], speed);
+            if (replay->Open())
+                source = std::move(replay);
+            break;
+        }
+
+        iRacingReputationApp app(std::move(source));
+        for (int i = 1; i < argc - 1; ++i)
+        {
+            if (std::string(argv[i]) == "--capture")
+                app.SetCapturePath(argv[i + 1]);
+        }
         app.Run();
         return 0;
     }
@@ -0,0 +1,411 @@
+/*
+MIT License - iRacing Reputation System
+Productor de telemetría para pruebas sin el simulador (iRacingTelemetryProducer)
+
+Publica filas de telemetría en la memoria compartida POSIX con el mismo layout que
+usa iRacing (irsdk_header + cabeceras de variables + YAML + triple buffer), al ritmo
+indicado, para poder medir el lector (latencia, ticks perdidos) fuera de Windows.
+
+Uso:
+    iRacingTelemetryProducer replay <archivo.ibt> [--hz 60|360] [--seconds N] [--loop]
+    iRacingTelemetryProducer synthetic [--cars N] [--filler N] [--hz 60|360] [--seconds N]
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Core/IRacingSDK/irsdk_defines.h"
+#include "Core/IRacingSDK/irsdk_diskclient.h"
+#include "Core/IRacingSDK/irsdk_platform.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<bool> g_stop{false};
+
+    void OnSignal(int)
+    {
+        g_stop = true;
+    }
+
+    struct ProducerOptions
+    {
+        int hz = 60;
+        double seconds = 0.0; // 0 = sin límite
+        bool loop = false;
+        int cars = 40;
+        int filler = 1000; // Variables float de relleno para acercar bufLen al del simulador
+    };
+
+    ProducerOptions ParseOptions(int argc, char **argv)
+    {
+        ProducerOptions options;
+        for (int i = 0; i < argc; ++i)
+        {
+            bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--hz") == 0 && hasValue)
+                options.hz = std::max(1, atoi(argv[++i]));
+            else if (strcmp(argv[i], "--seconds") == 0 && hasValue)
+                options.seconds = atof(argv[++i]);
+            else if (strcmp(argv[i], "--cars") == 0 && hasValue)
+                options.cars = std::min(64, std::max(1, atoi(argv[++i])));
+            else if (strcmp(argv[i], "--filler") == 0 && hasValue)
+                options.filler = std::max(0, atoi(argv[++i]));
+            else if (strcmp(argv[i], "--loop") == 0)
+                options.loop = true;
+        }
+        return options;
+    }
+
+    int Align16(int value)
+    {
+        return (value + 15) & ~15;
+    }
+
+    // Memoria compartida con el layout del simulador, publicada fila a fila
+    class SharedTelemetry
+    {
+    public:
+        ~SharedTelemetry() { Close(); }
+
+        bool Create(const std::vector<irsdk_varHeader> &vars, int bufLen, const std::string &sessionInfo, int tickRate)
+        {
+            const int numBuf = 3;
+            const int varHeaderOffset = Align16(sizeof(irsdk_header));
+            const int sessionInfoOffset = Align16(varHeaderOffset + static_cast<int>(vars.size() * sizeof(irsdk_varHeader)));
+            const int sessionInfoLen = Align16(static_cast<int>(sessionInfo.size()) + 1);
+            const int firstBufOffset = sessionInfoOffset + sessionInfoLen;
+            const int bufStride = Align16(bufLen);
+            const int totalSize = firstBufOffset + numBuf * bufStride;
+
+            m_mem = irsdkPlatform_createSharedMem(totalSize);
+            if (!m_mem)
+                return false;
+
+            m_header = reinterpret_cast<irsdk_header *>(m_mem);
+            m_header->ver = IRSDK_VER;
+            m_header->status = 0;
+            m_header->tickRate = tickRate;
+            m_header->sessionInfoUpdate = 1;
+            m_header->sessionInfoLen = sessionInfoLen;
+            m_header->sessionInfoOffset = sessionInfoOffset;
+            m_header->numVars = static_cast<int>(vars.size());
+            m_header->varHeaderOffset = varHeaderOffset;
+            m_header->numBuf = numBuf;
+            m_header->bufLen = bufLen;
+            for (int i = 0; i < numBuf; ++i)
+            {
+                m_header->varBuf[i].tickCount = -1;
+                m_header->varBuf[i].bufOffset = firstBufOffset + i * bufStride;
+            }
+
+            memcpy(m_mem + varHeaderOffset, vars.data(), vars.size() * sizeof(irsdk_varHeader));
+            memcpy(m_mem + sessionInfoOffset, sessionInfo.c_str(), sessionInfo.size() + 1);
+
+            // Visible para los lectores sólo cuando todo está escrito
+            std::atomic_thread_fence(std::memory_order_release);
+            m_header->status = irsdk_stConnected;
+            return true;
+        }
+
+        void Publish(const char *row, int tick)
+        {
+            // Se sobrescribe el buffer más antiguo; los lectores sólo miran el de tickCount mayor
+            irsdk_varBuf &buf = m_header->varBuf[tick % m_header->numBuf];
+            memcpy(m_mem + buf.bufOffset, row, m_header->bufLen);
+            std::atomic_thread_fence(std::memory_order_release);
+            buf.tickCount = tick;
+            irsdkPlatform_signalData();
+        }
+
+        void Close()
+        {
+            if (!m_mem)
+                return;
+            m_header->status = 0;
+            irsdkPlatform_signalData();
+            irsdkPlatform_destroySharedMem();
+            m_mem = nullptr;
+            m_header = nullptr;
+        }
+
+    private:
+        char *m_mem = nullptr;
+        irsdk_header *m_header = nullptr;
+    };
+
+    // Bucle a ritmo fijo con plazos absolutos; fillRow devuelve false para terminar
+    template <typename FillRow>
+    int RunLoop(SharedTelemetry &shared, std::vector<char> &row, const ProducerOptions &options, FillRow &&fillRow)
+    {
+        const auto period = std::chrono::nanoseconds(1000000000LL / options.hz);
+        const auto start = Clock::now();
+        auto deadline = start;
+        int tick = 0;
+        int late = 0;
+
+        while (!g_stop)
+        {
+            if (options.seconds > 0.0 && std::chrono::duration<double>(Clock::now() - start).count() >= options.seconds)
+                break;
+            if (!fillRow(row.data(), tick))
+                break;
+
+            std::this_thread::sleep_until(deadline);
+            if (Clock::now() - deadline > period)
+                late++;
+            shared.Publish(row.data(), tick);
+
+            tick++;
+            deadline += period;
+        }
+
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("Publicados %d ticks en %.2f s (%.1f Hz, objetivo %d Hz), %d tarde más de un periodo\n",
+               tick, elapsed, elapsed > 0.0 ? tick / elapsed : 0.0, options.hz, late);
+        return 0;
+    }
+
+    int RunReplay(const char *path, const ProducerOptions &options)
+    {
+        irsdkDiskClient file(path);
+        if (!file.isFileOpen())
+        {
+            printf("No se pudo abrir %s\n", path);
+            return 1;
+        }
+
+        const irsdk_header *header = file.getHeader();
+        std::vector<irsdk_varHeader> vars(file.getVarHeaders(), file.getVarHeaders() + header->numVars);
+        std::string sessionInfo = file.getSessionStr() ? file.getSessionStr() : "";
+
+        SharedTelemetry shared;
+        if (!shared.Create(vars, header->bufLen, sessionInfo, options.hz))
+        {
+            printf("No se pudo crear la memoria compartida\n");
+            return 1;
+        }
+
+        printf("Reproduciendo %s: %d variables, %d bytes por fila, %d registros a %d Hz\n",
+               path, header->numVars, header->bufLen, file.getDataCount(), options.hz);
+
+        std::vector<char> row(header->bufLen);
+        return RunLoop(shared, row, options, [&](char *out, int)
+                       {
+                           if (!file.getNextData())
+                           {
+                               if (!options.loop || !file.openFile(path) || !file.getNextData())
+                                   return false;
+                           }
+                           memcpy(out, file.getData(), row.size());
+                           return true; });
+    }
+
+    // Variables mínimas que lee la aplicación más relleno, con datos de una carrera sintética
+    class SyntheticSession
+    {
+    public:
+        explicit SyntheticSession(const ProducerOptions &options) : m_cars(options.cars)
+        {
+            Add("SessionTick", irsdk_int, 1, m_sessionTick);
+            Add("SessionTime", irsdk_double, 1, m_sessionTime);
+            Add("SessionNum", irsdk_int, 1, m_sessionNum);
+            Add("SessionState", irsdk_int, 1, m_sessionState);
+            Add("PlayerCarIdx", irsdk_int, 1, m_playerCarIdx);
+            Add("IsOnTrack", irsdk_bool, 1, m_isOnTrack);
+            Add("IsOnTrackCar", irsdk_bool, 1, m_isOnTrackCar);
+            Add("CarIdxLap", irsdk_int, 64, m_lap);
+            Add("CarIdxLapDistPct", irsdk_float, 64, m_lapDistPct);
+            Add("CarIdxEstTime", irsdk_float, 64, m_estTime);
+            Add("CarIdxPosition", irsdk_int, 64, m_position);
+            Add("CarIdxClassPosition", irsdk_int, 64, m_classPosition);
+            Add("CarIdxOnPitRoad", irsdk_bool, 64, m_onPitRoad);
+            Add("CarIdxTrackSurface", irsdk_int, 64, m_trackSurface);
+            for (int i = 0; i < options.filler; ++i)
+            {
+                char name[IRSDK_MAX_STRING];
+                snprintf(name, sizeof(name), "Filler%04d", i);
+                int unused;
+                Add(name, irsdk_float, 1, unused);
+            }
+
+            m_bufLen = Align16(m_nextOffset);
+            BuildSessionInfo();
+        }
+
+        const std::vector<irsdk_varHeader> &Vars() const { return m_vars; }
+        int BufLen() const { return m_bufLen; }
+        const std::string &SessionInfo() const { return m_sessionInfo; }
+
+        void Fill(char *row, int tick, int hz)
+        {
+            const double time = static_cast<double>(tick) / hz;
+            const float trackLength = 5000.0f;
+            float progress[64] = {};
+
+            memset(row, 0, m_bufLen);
+            Write<int>(row, m_sessionTick, 0, tick);
+            Write<double>(row, m_sessionTime, 0, time);
+            Write<int>(row, m_sessionNum, 0, 0);
+            Write<int>(row, m_sessionState, 0, irsdk_StateRacing);
+            Write<int>(row, m_playerCarIdx, 0, 0);
+            Write<bool>(row, m_isOnTrack, 0, true);
+            Write<bool>(row, m_isOnTrackCar, 0, true);
+
+            for (int car = 0; car < 64; ++car)
+            {
+                if (car >= m_cars)
+                {
+                    Write<float>(row, m_lapDistPct, car, -1.0f);
+                    Write<int>(row, m_lap, car, -1);
+                    Write<int>(row, m_trackSurface, car, irsdk_NotInWorld);
+                    continue;
+                }
+
+                // Cada coche a velocidad constante ligeramente distinta, salida escalonada
+                const double speed = 50.0 + 0.15 * ((car * 37) % 20);
+                const double distance = speed * time - car * 12.0;
+                const double laps = distance / trackLength;
+                const double pct = laps - std::floor(laps);
+                progress[car] = static_cast<float>(laps);
+
+                Write<float>(row, m_lapDistPct, car, static_cast<float>(pct));
+                Write<int>(row, m_lap, car, static_cast<int>(std::floor(laps)) + 1);
+                Write<float>(row, m_estTime, car, static_cast<float>(pct * trackLength / 50.0));
+
+                // Uno de cada ocho coches pasa por el pit lane en los últimos 150 m de cada vuelta
+                const bool inPitLane = car % 8 == 7 && pct > 0.97;
+                Write<bool>(row, m_onPitRoad, car, inPitLane);
+                Write<int>(row, m_trackSurface, car, inPitLane ? irsdk_AproachingPits : irsdk_OnTrack);
+            }
+
+            for (int car = 0; car < m_cars; ++car)
+            {
+                int position = 1;
+                for (int other = 0; other < m_cars; ++other)
+                    position += progress[other] > progress[car] ? 1 : 0;
+                Write<int>(row, m_position, car, position);
+                Write<int>(row, m_classPosition, car, position);
+            }
+        }
+
+    private:
+        void Add(const char *name, int type, int count, int &offset)
+        {
+            const int size = irsdk_VarTypeBytes[type];
+            m_nextOffset = (m_nextOffset + size - 1) / size * size;
+
+            irsdk_varHeader header;
+            memset(&header, 0, sizeof(header));
+            header.type = type;
+            header.offset = m_nextOffset;
+            header.count = count;
+            snprintf(header.name, sizeof(header.name), "%s", name);
+            m_vars.push_back(header);
+
+            offset = m_nextOffset;
+            m_nextOffset += size * count;
+        }
+
+        template <typename T>
+        void Write(char *row, int offset, int entry, T value)
+        {
+            memcpy(row + offset + entry * sizeof(T), &value, sizeof(T));
+        }
+
+        void BuildSessionInfo()
+        {
+            char line[256];
+            m_sessionInfo = "---\nWeekendInfo:\n TrackName: synthetic\n TrackDisplayName: Synthetic Speedway\n"
+                            " TrackLength: 5.00 km\n TrackID: 1\n SeriesID: 1\n SubSessionID: 1\n EventType: Race\n\n"
+                            "SessionInfo:\n Sessions:\n - SessionNum: 0\n   SessionType: Race\n   SessionName: RACE\n\n"
+                            "DriverInfo:\n DriverCarIdx: 0\n Drivers:\n";
+            for (int car = 0; car < m_cars; ++car)
+            {
+                snprintf(line, sizeof(line),
+                         " - CarIdx: %d\n   UserName: Synthetic Driver %d\n   UserID: %d\n   CarNumber: \"%d\"\n"
+                         "   CarIsPaceCar: 0\n   CarScreenName: Synthetic Car\n   IRating: %d\n   LicString: A 3.50\n"
+                         "   IsSpectator: 0\n   CurDriverIncidentCount: 0\n",
+                         car, car, 500000 + car, car + 1, 1500 + car * 25);
+                m_sessionInfo += line;
+            }
+            m_sessionInfo += "\n...\n";
+        }
+
+        int m_cars;
+        int m_nextOffset = 0;
+        int m_bufLen = 0;
+        std::vector<irsdk_varHeader> m_vars;
+        std::string m_sessionInfo;
+
+        int m_sessionTick = 0, m_sessionTime = 0, m_sessionNum = 0, m_sessionState = 0, m_playerCarIdx = 0;
+        int m_isOnTrack = 0, m_isOnTrackCar = 0;
+        int m_lap = 0, m_lapDistPct = 0, m_estTime = 0, m_position = 0, m_classPosition = 0;
+        int m_onPitRoad = 0, m_trackSurface = 0;
+    };
+
+    int RunSynthetic(const ProducerOptions &options)
+    {
+        SyntheticSession session(options);
+
+        SharedTelemetry shared;
+        if (!shared.Create(session.Vars(), session.BufLen(), session.SessionInfo(), options.hz))
+        {
+            printf("No se pudo crear la memoria compartida\n");
+            return 1;
+        }
+
+        printf("Sesión sintética: %d coches, %d variables, %d bytes por fila a %d Hz\n",
+               options.cars, static_cast<int>(session.Vars().size()), session.BufLen(), options.hz);
+
+        std::vector<char> row(session.BufLen());
+        return RunLoop(shared, row, options, [&](char *out, int tick)
+                       {
+                           session.Fill(out, tick, options.hz);
+                           return true; });
+    }
+
+    void PrintUsage()
+    {
+        printf("Uso:\n");
+        printf("  iRacingTelemetryProducer replay <archivo.ibt> [--hz 60|360] [--seconds N] [--loop]\n");
+        printf("  iRacingTelemetryProducer synthetic [--cars N] [--filler N] [--hz 60|360] [--seconds N]\n");
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+#ifdef _WIN32
+    // En Windows la memoria compartida la crea el propio simulador
+    printf("iRacingTelemetryProducer sólo está disponible en POSIX\n");
+    return 1;
+#else
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::signal(SIGINT, OnSignal);
+    std::signal(SIGTERM, OnSignal);
+
+    if (strcmp(argv[1], "replay") == 0 && argc >= 3)
+        return RunReplay(argv[2], ParseOptions(argc - 3, argv + 3));
+
+    if (strcmp(argv[1], "synthetic") == 0)
+        return RunSynthetic(ParseOptions(argc - 2, argv + 2));
+
+    PrintUsage();
+    return 1;
+#endif
+}